@@ -3,10 +3,25 @@
                       families of related objects without specifying their concrete classes.
                       It is useful when a system needs to be independent of how its objects
                       are created, composed, and represented.
+
+                      createMany(n) builds n products of the factory's type in one contiguous
+                      slab, so creating and then iterating many products avoids per-object
+                      allocations and keeps virtual calls over them predictable.
+
+                      When the family is fixed, FamilyFactory<Family> selects it at compile time:
+                      products are returned by value or constructed in place, and calls on them
+                      need no virtual dispatch. dispatchFamily picks a family at runtime once and
+                      then runs a whole batch against the compile-time factory.
 */
 
 // Include standard libraries
-#include <iostream>
+#include "../../common/output_sink.h"
+#include "../../common/slab.h"
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
 
 // Create an abstract product (base class for products)
 class Animal {
@@ -19,14 +34,14 @@ public:
 class Dog : public Animal {
 public:
     void makeSound() override {
-        std::cout << "Woof!" << std::endl;
+        output() << "Woof!\n";
     }
 };
 
 class Cat : public Animal {
 public:
     void makeSound() override {
-        std::cout << "Meow!" << std::endl;
+        output() << "Meow!\n";
     }
 };
 
@@ -34,6 +49,7 @@ public:
 class AnimalFactory {
 public:
     virtual Animal* createAnimal() = 0; // Pure virtual function
+    virtual Slab<Animal> createMany(size_t count) = 0; // count products in one contiguous slab
     virtual ~AnimalFactory() {} // Virtual destructor
 };
 
@@ -43,6 +59,9 @@ public:
     Animal* createAnimal() override {
         return new Dog(); // Creates a Dog object
     }
+    Slab<Animal> createMany(size_t count) override {
+        return Slab<Animal>::make<Dog>(count); // Creates count Dog objects
+    }
 };
 
 class CatFactory : public AnimalFactory {
@@ -50,8 +69,179 @@ public:
     Animal* createAnimal() override {
         return new Cat(); // Creates a Cat object
     }
+    Slab<Animal> createMany(size_t count) override {
+        return Slab<Animal>::make<Cat>(count); // Creates count Cat objects
+    }
+};
+
+// Product families: the concrete types a compile-time factory creates
+struct DogFamily {
+    using AnimalType = Dog;
+};
+
+struct CatFamily {
+    using AnimalType = Cat;
+};
+
+// Compile-time abstract factory: the family is a type parameter, so there is no factory object
+// to call through and products are concrete types
+template <typename Family>
+class FamilyFactory {
+public:
+    using AnimalType = typename Family::AnimalType;
+
+    AnimalType createAnimal() const { return AnimalType(); } // By value
+
+    AnimalType* createAnimalAt(void* storage) const { return new (storage) AnimalType(); } // In place
+};
+
+// Runtime family selection: one dispatch on index, then body(FamilyFactory<F>()) runs with the
+// family fixed at compile time. body is instantiated once per family.
+template <typename... Families, typename Body>
+void dispatchFamily(size_t index, Body&& body) {
+    size_t current = 0;
+    bool dispatched = false;
+    using expand = int[];
+    (void)expand{ 0, (current++ == index ? (body(FamilyFactory<Families>()), dispatched = true, 0) : 0)... };
+    if (!dispatched) {
+        throw std::out_of_range("Unknown animal family");
+    }
+}
+
+// Benchmark products: count their calls instead of printing. volatile keeps every call's effect,
+// so loops over inlined products cannot be folded into one addition.
+volatile int64_t soundsMade = 0;
+
+class QuietDog final : public Animal {
+private:
+    int64_t weight = 2;
+public:
+    void makeSound() override { soundsMade = soundsMade + weight; }
+};
+
+class QuietCat final : public Animal {
+private:
+    int64_t weight = 1;
+public:
+    void makeSound() override { soundsMade = soundsMade + weight; }
 };
 
+template <typename Product>
+class QuietFactory : public AnimalFactory {
+public:
+    Animal* createAnimal() override { return new Product(); }
+    Slab<Animal> createMany(size_t count) override { return Slab<Animal>::make<Product>(count); }
+};
+
+// Benchmark: create, iterate and destroy 10M mixed products, one new per object versus slabs
+void benchmarkCreateMany() {
+    using Clock = std::chrono::steady_clock;
+    const size_t productCount = 10000000;
+    QuietFactory<QuietDog> dogFactory;
+    QuietFactory<QuietCat> catFactory;
+    AnimalFactory* factories[] = { &dogFactory, &catFactory };
+
+    auto start = Clock::now();
+    soundsMade = 0;
+    {
+        std::vector<Animal*> animals;
+        animals.reserve(productCount);
+        uint64_t seed = 7;
+        for (size_t i = 0; i < productCount; ++i) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            animals.push_back(factories[seed >> 63]->createAnimal()); // Types interleaved at random
+        }
+        for (Animal* animal : animals) {
+            animal->makeSound();
+        }
+        for (Animal* animal : animals) {
+            delete animal;
+        }
+    }
+    double individualSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    int64_t individualSounds = soundsMade;
+
+    start = Clock::now();
+    soundsMade = 0;
+    {
+        std::vector<Slab<Animal>> slabs;
+        for (AnimalFactory* factory : factories) {
+            slabs.push_back(factory->createMany(productCount / 2));
+        }
+        for (const Slab<Animal>& slab : slabs) {
+            for (Animal& animal : slab) {
+                animal.makeSound();
+            }
+        }
+    }
+    double slabSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    output() << "individual new: " << productCount / individualSeconds / 1e6 << " M products/s (" << individualSounds << ")\n";
+    output() << "createMany:     " << productCount / slabSeconds / 1e6 << " M products/s (" << soundsMade << ")\n";
+    flushOutput();
+}
+
+struct QuietDogFamily {
+    using AnimalType = QuietDog;
+};
+
+struct QuietCatFamily {
+    using AnimalType = QuietCat;
+};
+
+// Benchmark: batches of products through the virtual factory, a compile-time family, and a
+// runtime-selected family with one dispatch per batch
+void benchmarkFamilies() {
+    using Clock = std::chrono::steady_clock;
+    const size_t batchCount = 1000;
+    const size_t batchSize = 10000;
+    const double productCount = static_cast<double>(batchCount * batchSize);
+    QuietFactory<QuietDog> dogFactory;
+    QuietFactory<QuietCat> catFactory;
+    AnimalFactory* factories[] = { &dogFactory, &catFactory };
+
+    auto report = [&](const char* label, Clock::time_point start) {
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        output() << label << productCount / seconds / 1e6 << " M products/s (" << soundsMade << ")\n";
+    };
+
+    soundsMade = 0;
+    auto start = Clock::now();
+    for (size_t batch = 0; batch < batchCount; ++batch) {
+        AnimalFactory* factory = factories[batch % 2];
+        for (size_t i = 0; i < batchSize; ++i) {
+            Animal* animal = factory->createAnimal();
+            animal->makeSound();
+            delete animal;
+        }
+    }
+    report("virtual factory:        ", start);
+
+    soundsMade = 0;
+    start = Clock::now();
+    FamilyFactory<QuietDogFamily> fixedFactory;
+    for (size_t batch = 0; batch < batchCount; ++batch) {
+        for (size_t i = 0; i < batchSize; ++i) {
+            QuietDog animal = fixedFactory.createAnimal();
+            animal.makeSound();
+        }
+    }
+    report("compile-time family:    ", start);
+
+    soundsMade = 0;
+    start = Clock::now();
+    for (size_t batch = 0; batch < batchCount; ++batch) {
+        dispatchFamily<QuietDogFamily, QuietCatFamily>(batch % 2, [&](auto factory) {
+            for (size_t i = 0; i < batchSize; ++i) {
+                auto animal = factory.createAnimal();
+                animal.makeSound();
+            }
+        });
+    }
+    report("runtime family / batch: ", start);
+    flushOutput();
+}
+
 // Use the factory to create objects
 int main() {
     AnimalFactory* factory1 = new DogFactory(); // Create a Dog factory
@@ -66,5 +256,24 @@ int main() {
     delete cat;
     delete factory2;
 
+    // Create several animals at once
+    DogFactory dogFactory;
+    Slab<Animal> dogs = dogFactory.createMany(3);
+    for (Animal& animal : dogs) {
+        animal.makeSound(); // Output: Woof! (three times)
+    }
+
+    // Family fixed at compile time; the product is returned by value
+    FamilyFactory<CatFamily> catFamily;
+    Cat cat2 = catFamily.createAnimal();
+    cat2.makeSound(); // Output: Meow!
+
+    // Family chosen at runtime, once, then used with its compile-time factory
+    dispatchFamily<DogFamily, CatFamily>(0, [](auto family) {
+        family.createAnimal().makeSound(); // Output: Woof!
+    });
+
+    benchmarkCreateMany();
+    benchmarkFamilies();
     return 0;
 }
\ No newline at end of file
@@ -5,13 +5,13 @@
 */
 
 // Include necessary headers
-#include <iostream>
+#include "../../common/output_sink.h"
 
  // Existing (Old) class with an incompatible interface
 class OldPrinter {
 public:
     void oldPrint() {
-        std::cout << "Printing using OldPrinter" << std::endl;
+        output() << "Printing using OldPrinter\n";
     }
 };
 
@@ -6,7 +6,7 @@
 */
 
 // Include necessary headers
-#include <iostream>
+#include "../../common/output_sink.h"
 
 // Implementation interface (defines the low-level behavior)
 class Device {
@@ -20,10 +20,10 @@ public:
 class TV : public Device {
 public:
     void turnOn() override {
-        std::cout << "TV is now ON" << std::endl;
+        output() << "TV is now ON\n";
     }
     void turnOff() override {
-        std::cout << "TV is now OFF" << std::endl;
+        output() << "TV is now OFF\n";
     }
 };
 
@@ -31,10 +31,10 @@ public:
 class Radio : public Device {
 public:
     void turnOn() override {
-        std::cout << "Radio is now ON" << std::endl;
+        output() << "Radio is now ON\n";
     }
     void turnOff() override {
-        std::cout << "Radio is now OFF" << std::endl;
+        output() << "Radio is now OFF\n";
     }
 };
 
@@ -58,7 +58,7 @@ class AdvancedRemote : public RemoteControl {
 public:
     AdvancedRemote(Device* dev) : RemoteControl(dev) {}
     void mute() {
-        std::cout << "Device is now MUTED" << std::endl;
+        output() << "Device is now MUTED\n";
     }
 };
 
@@ -7,11 +7,32 @@ Builder: Used to construct complex objects step by step. It allows for the creat
          - Builder Interface: Specifies steps to build the product.
          - Concrete Builder: Implements the steps defined in the Builder Interface.
          - Director (Optional): Directs the building process.
+
+         Builders are reusable: reset() starts the next product in place, either in the
+         builder's own storage or in caller-provided/pooled storage, so building reuses
+         existing string capacity instead of allocating. Parts can be moved in, and the
+         finished product is moved out. FluentBuilder checks the required steps at compile time.
+
+         A BuildPlan declares the build steps and their dependencies. ParallelDirector runs
+         every step whose dependencies are done concurrently on a thread pool, and returns
+         once all steps have finished, so getResult() sees the complete product.
 */
 
 // Include headers
-#include <iostream>
+#include "../../common/output_sink.h"
 #include <string>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
 
 // Product: The complex object being built
 class Product {
@@ -19,39 +40,447 @@ public:
     std::string partA;
     std::string partB;
     void show() {
-        std::cout << "Product Parts: " << partA << ", " << partB << std::endl;
+        output() << "Product Parts: " << partA << ", " << partB << '\n';
     }
 };
 
 // Builder Interface
 class Builder {
 public:
+    virtual void reset() = 0; // Start a new product
     virtual void buildPartA() = 0;
     virtual void buildPartB() = 0;
-    virtual Product* getResult() = 0;
+    virtual Product getResult() = 0; // The finished product
     virtual ~Builder() {}
 };
 
-// Concrete Builder
+// Concrete Builder: builds into its own product or into storage supplied by the caller
 class ConcreteBuilder : public Builder {
 private:
+    std::string defaultPartA;
+    std::string defaultPartB;
+    Product ownProduct;
     Product* product;
 public:
-    ConcreteBuilder() { product = new Product(); }
-    void buildPartA() override { product->partA = "Part A"; }
-    void buildPartB() override { product->partB = "Part B"; }
-    Product* getResult() override { return product; }
+    explicit ConcreteBuilder(std::string partA = "Part A", std::string partB = "Part B")
+        : defaultPartA(std::move(partA)), defaultPartB(std::move(partB)), product(&ownProduct) {}
+
+    void reset() override { reset(ownProduct); }
+
+    // Build the next product in place in target; existing string capacity is reused
+    void reset(Product& target) {
+        product = &target;
+        product->partA.clear();
+        product->partB.clear();
+    }
+
+    void buildPartA() override { product->partA.assign(defaultPartA); }
+    void buildPartB() override { product->partB.assign(defaultPartB); }
+
+    // Supply parts directly: rvalues are moved in, lvalues are copied into the existing capacity
+    void setPartA(std::string&& part) { product->partA = std::move(part); }
+    void setPartA(const std::string& part) { product->partA.assign(part); }
+    void setPartB(std::string&& part) { product->partB = std::move(part); }
+    void setPartB(const std::string& part) { product->partB.assign(part); }
+
+    // Builder-owned product: moved out. Caller-provided storage already holds the product and
+    // keeps it, with its capacity; the result is a copy.
+    Product getResult() override {
+        if (product == &ownProduct) {
+            return std::move(ownProduct);
+        }
+        return *product;
+    }
+
+    // The product under construction, for callers that built into their own storage
+    Product& current() { return *product; }
+};
+
+// ProductPool: Recycles products so their strings keep their capacity between builds
+class ProductPool {
+private:
+    std::vector<std::unique_ptr<Product>> available;
+public:
+    std::unique_ptr<Product> acquire() {
+        if (available.empty()) {
+            return std::unique_ptr<Product>(new Product());
+        }
+        std::unique_ptr<Product> product = std::move(available.back());
+        available.pop_back();
+        return product;
+    }
+
+    void release(std::unique_ptr<Product> product) {
+        available.push_back(std::move(product));
+    }
+};
+
+// FluentBuilder: Tracks the required steps in its type, so build() only compiles once both
+// parts are set. The flags exist only at compile time; the object is just the product.
+template <bool HasPartA = false, bool HasPartB = false>
+class FluentBuilder {
+private:
+    template <bool, bool> friend class FluentBuilder;
+    Product product;
+
+    explicit FluentBuilder(Product&& from) : product(std::move(from)) {}
+
+public:
+    FluentBuilder() {}
+
+    FluentBuilder<true, HasPartB> partA(std::string part) && {
+        static_assert(!HasPartA, "Part A is already set");
+        product.partA = std::move(part);
+        return FluentBuilder<true, HasPartB>(std::move(product));
+    }
+
+    FluentBuilder<HasPartA, true> partB(std::string part) && {
+        static_assert(!HasPartB, "Part B is already set");
+        product.partB = std::move(part);
+        return FluentBuilder<HasPartA, true>(std::move(product));
+    }
+
+    Product build() && {
+        static_assert(HasPartA && HasPartB, "Both parts must be set before build()");
+        return std::move(product);
+    }
 };
 
 // Director (Optional)
 class Director {
 public:
     void construct(Builder& builder) {
+        builder.reset();
         builder.buildPartA();
         builder.buildPartB();
     }
 };
 
+// ThreadPool: Fixed set of workers running submitted tasks in FIFO order
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable available;
+    std::deque<std::function<void()>> tasks;
+    bool stopping = false;
+
+    void workerLoop() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                available.wait(lock, [&] { return stopping || !tasks.empty(); });
+                if (tasks.empty()) {
+                    return; // Stopping and drained
+                }
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+public:
+    explicit ThreadPool(size_t threadCount) {
+        for (size_t i = 0; i < std::max<size_t>(1, threadCount); ++i) {
+            workers.emplace_back(&ThreadPool::workerLoop, this);
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        available.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.push_back(std::move(task));
+        }
+        available.notify_one();
+    }
+};
+
+// BuildPlan: Build steps and the steps each one depends on, typed on the builder they drive so
+// steps can use that builder's own operations. Steps that run concurrently must touch different
+// parts of the product.
+template <typename BuilderType>
+class BuildPlan {
+public:
+    struct Step {
+        std::string name;
+        std::function<void(BuilderType&)> action;
+        std::vector<size_t> dependencies;
+    };
+
+private:
+    std::vector<Step> steps;
+
+public:
+    // Add a step that may start once all dependencies (ids returned by earlier calls) are done
+    size_t addStep(std::string name, std::function<void(BuilderType&)> action, std::vector<size_t> dependencies = {}) {
+        for (size_t dependency : dependencies) {
+            if (dependency >= steps.size()) {
+                throw std::invalid_argument("Step " + name + " depends on an unknown step");
+            }
+        }
+        steps.push_back(Step{ std::move(name), std::move(action), std::move(dependencies) });
+        return steps.size() - 1;
+    }
+
+    const std::vector<Step>& getSteps() const { return steps; }
+};
+
+// ParallelDirector: Runs a BuildPlan on a thread pool, starting each step as soon as its
+// dependencies finish. construct() returns after every step has run; the first exception thrown
+// by a step is rethrown there, and steps depending on a failed step are skipped.
+class ParallelDirector {
+private:
+    // Bookkeeping for one construct() call, shared by the caller and every task it submits so it
+    // outlives whichever of them finishes last
+    template <typename BuilderType>
+    struct Construction {
+        BuilderType& builder;
+        const std::vector<typename BuildPlan<BuilderType>::Step>& steps;
+        ThreadPool& pool;
+        std::vector<size_t> waitingOn;
+        std::vector<std::vector<size_t>> dependents;
+        std::mutex mutex;
+        std::condition_variable finished;
+        size_t remaining;
+        std::exception_ptr failure;
+
+        Construction(BuilderType& b, const BuildPlan<BuilderType>& plan, ThreadPool& threadPool)
+            : builder(b), steps(plan.getSteps()), pool(threadPool), waitingOn(steps.size()),
+              dependents(steps.size()), remaining(steps.size()) {
+            for (size_t i = 0; i < steps.size(); ++i) {
+                waitingOn[i] = steps[i].dependencies.size();
+                for (size_t dependency : steps[i].dependencies) {
+                    dependents[dependency].push_back(i);
+                }
+            }
+        }
+    };
+
+    template <typename BuilderType>
+    static void submit(const std::shared_ptr<Construction<BuilderType>>& state, size_t index) {
+        state->pool.submit([state, index] { run(state, index); });
+    }
+
+    template <typename BuilderType>
+    static void run(const std::shared_ptr<Construction<BuilderType>>& state, size_t index) {
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            error = state->failure;
+        }
+        if (!error) {
+            try {
+                state->steps[index].action(state->builder);
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+        }
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (error && !state->failure) {
+            state->failure = error;
+        }
+        for (size_t dependent : state->dependents[index]) {
+            if (--state->waitingOn[dependent] == 0) {
+                submit(state, dependent);
+            }
+        }
+        if (--state->remaining == 0) {
+            state->finished.notify_one();
+        }
+    }
+
+    ThreadPool& pool;
+
+public:
+    explicit ParallelDirector(ThreadPool& threadPool) : pool(threadPool) {}
+
+    template <typename BuilderType>
+    void construct(BuilderType& builder, const BuildPlan<BuilderType>& plan) {
+        builder.reset();
+        if (plan.getSteps().empty()) {
+            return;
+        }
+        auto state = std::make_shared<Construction<BuilderType>>(builder, plan, pool);
+        std::unique_lock<std::mutex> lock(state->mutex);
+        for (size_t i = 0; i < state->steps.size(); ++i) {
+            if (state->waitingOn[i] == 0) {
+                submit(state, i);
+            }
+        }
+        state->finished.wait(lock, [&] { return state->remaining == 0; });
+        if (state->failure) {
+            std::rethrow_exception(state->failure);
+        }
+    }
+};
+
+// Builder with expensive, independent parts and a final step that needs both
+class ExpensiveBuilder : public Builder {
+private:
+    Product product;
+    std::chrono::milliseconds partCost;
+public:
+    explicit ExpensiveBuilder(std::chrono::milliseconds cost) : partCost(cost) {}
+
+    void reset() override {
+        product.partA.clear();
+        product.partB.clear();
+    }
+
+    void buildPartA() override {
+        std::this_thread::sleep_for(partCost); // Simulated expensive work
+        product.partA = "Part A";
+    }
+
+    void buildPartB() override {
+        std::this_thread::sleep_for(partCost);
+        product.partB = "Part B";
+    }
+
+    // Depends on both parts
+    void finish() {
+        std::this_thread::sleep_for(partCost / 2);
+        product.partA += " (checked against " + product.partB + ")";
+    }
+
+    Product getResult() override { return std::move(product); }
+};
+
+// Benchmark: wall clock of sequential and parallel directors with simulated expensive parts
+void benchmarkParallelDirector() {
+    using Clock = std::chrono::steady_clock;
+    const size_t productCount = 20;
+    ExpensiveBuilder builder(std::chrono::milliseconds(10));
+
+    auto start = Clock::now();
+    Director director;
+    for (size_t i = 0; i < productCount; ++i) {
+        director.construct(builder);
+        builder.finish();
+        builder.getResult();
+    }
+    double sequentialSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    ThreadPool pool(4);
+    BuildPlan<ExpensiveBuilder> plan;
+    size_t partA = plan.addStep("Part A", [](ExpensiveBuilder& b) { b.buildPartA(); });
+    size_t partB = plan.addStep("Part B", [](ExpensiveBuilder& b) { b.buildPartB(); });
+    plan.addStep("Finish", [](ExpensiveBuilder& b) { b.finish(); }, { partA, partB });
+
+    start = Clock::now();
+    ParallelDirector parallelDirector(pool);
+    Product last;
+    for (size_t i = 0; i < productCount; ++i) {
+        parallelDirector.construct(builder, plan);
+        last = builder.getResult();
+    }
+    double parallelSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    output() << "sequential director: " << sequentialSeconds * 1000 / productCount << " ms/product\n";
+    output() << "parallel director:   " << parallelSeconds * 1000 / productCount << " ms/product\n";
+    last.show();
+    flushOutput();
+}
+
+// Keep a built product observable so the benchmark loops cannot be folded away
+const char* volatile observedPart = nullptr;
+
+inline size_t observe(const Product& product) {
+    observedPart = product.partA.data();
+    observedPart = product.partB.data();
+    return product.partA.size() + product.partB.size();
+}
+
+// Benchmark: products per second for each way of building, all with the same long parts
+void benchmarkBuilders() {
+    using Clock = std::chrono::steady_clock;
+    const size_t productCount = 10000000;
+    const std::string longPartA = "Part A with a description too long for the small string buffer";
+    const std::string longPartB = "Part B with a description too long for the small string buffer";
+
+    auto report = [&](const char* label, Clock::time_point start, size_t checksum) {
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        output() << label << productCount / seconds / 1e6 << " M products/s (checksum " << checksum << ")\n";
+    };
+
+    // Previous behaviour: a heap-allocated product per build with copied parts
+    auto start = Clock::now();
+    size_t checksum = 0;
+    for (size_t i = 0; i < productCount; ++i) {
+        Product* product = new Product();
+        product->partA = longPartA;
+        product->partB = longPartB;
+        checksum += observe(*product);
+        delete product;
+    }
+    report("new product per build:     ", start, checksum);
+
+    // One builder reused, building in place into caller-provided storage
+    start = Clock::now();
+    checksum = 0;
+    ConcreteBuilder builder(longPartA, longPartB);
+    Product target;
+    for (size_t i = 0; i < productCount; ++i) {
+        builder.reset(target);
+        builder.setPartA(longPartA);
+        builder.setPartB(longPartB);
+        checksum += observe(target);
+    }
+    report("reused builder, in place:  ", start, checksum);
+
+    // Pooled storage: products are recycled with their capacity
+    start = Clock::now();
+    checksum = 0;
+    ProductPool pool;
+    for (size_t i = 0; i < productCount; ++i) {
+        std::unique_ptr<Product> product = pool.acquire();
+        builder.reset(*product);
+        builder.setPartA(longPartA);
+        builder.setPartB(longPartB);
+        checksum += observe(*product);
+        pool.release(std::move(product));
+    }
+    report("reused builder, pooled:    ", start, checksum);
+
+    // Director with the reusable builder; the product is moved out, so its buffers go with it
+    start = Clock::now();
+    checksum = 0;
+    Director director;
+    for (size_t i = 0; i < productCount; ++i) {
+        director.construct(builder);
+        Product product = builder.getResult();
+        checksum += observe(product);
+    }
+    report("director, moved out:       ", start, checksum);
+
+    // Type-checked fluent builder; parts copied in
+    start = Clock::now();
+    checksum = 0;
+    for (size_t i = 0; i < productCount; ++i) {
+        Product product = FluentBuilder<>().partA(longPartA).partB(longPartB).build();
+        checksum += observe(product);
+    }
+    report("fluent builder:            ", start, checksum);
+    flushOutput();
+}
+
 // Client Code
 int main() {
 	// Create the builder and director
@@ -62,12 +491,19 @@ int main() {
     director.construct(builder);
 
     // Retrieve the finished product
-    Product* product = builder.getResult();
-    product->show();
+    Product product = builder.getResult();
+    product.show();
 
-    // Clean up
-    delete product;
-    return 0;
-}
+    // Reuse the builder, with parts moved in
+    builder.reset();
+    builder.setPartA("Custom A");
+    builder.setPartB("Custom B");
+    builder.getResult().show();
 
+    // Required steps checked at compile time
+    FluentBuilder<>().partB("Fluent B").partA("Fluent A").build().show();
 
+    benchmarkBuilders();
+    benchmarkParallelDirector();
+    return 0;
+}
\ No newline at end of file
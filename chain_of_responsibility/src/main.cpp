@@ -5,7 +5,7 @@
 */
 
 // Include necessary headers
-#include <iostream>
+#include "../../common/output_sink.h"
 
 // Abstract Handler class
 class Handler {
@@ -21,7 +21,7 @@ protected:
             nextHandler->handleRequest(request);
         }
         else {
-            std::cout << "Request " << request << " could not be handled.\n";
+            output() << "Request " << request << " could not be handled.\n";
         }
     }
 
@@ -34,7 +34,7 @@ class ConcreteHandler1 : public Handler {
 public:
     void handleRequest(int request) override {
         if (request < 10) {
-            std::cout << "ConcreteHandler1 handled request " << request << "\n";
+            output() << "ConcreteHandler1 handled request " << request << "\n";
         }
         else {
             Handler::handleRequest(request);
@@ -47,7 +47,7 @@ class ConcreteHandler2 : public Handler {
 public:
     void handleRequest(int request) override {
         if (request >= 10 && request < 20) {
-            std::cout << "ConcreteHandler2 handled request " << request << "\n";
+            output() << "ConcreteHandler2 handled request " << request << "\n";
         }
         else {
             Handler::handleRequest(request);
@@ -60,7 +60,7 @@ class ConcreteHandler3 : public Handler {
 public:
     void handleRequest(int request) override {
         if (request >= 20 && request < 30) {
-            std::cout << "ConcreteHandler3 handled request " << request << "\n";
+            output() << "ConcreteHandler3 handled request " << request << "\n";
         }
         else {
             Handler::handleRequest(request);
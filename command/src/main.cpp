@@ -11,7 +11,7 @@
  */
 
 // Include necessary headers
-#include <iostream>
+#include "../../common/output_sink.h"
 
 // Command Interface
 class Command {
@@ -23,8 +23,8 @@ public:
 // Receiver (Performs actual operations)
 class Light {
 public:
-    void turnOn() { std::cout << "Light is ON" << std::endl; }
-    void turnOff() { std::cout << "Light is OFF" << std::endl; }
+    void turnOn() { output() << "Light is ON\n"; }
+    void turnOff() { output() << "Light is OFF\n"; }
 };
 
 // Concrete Commands
@@ -0,0 +1,194 @@
+/*
+    Output sink shared by the pattern examples.
+
+    Examples write through output() instead of std::cout. Each thread gets its own
+    OutputWriter that collects text in a fixed buffer and hands it to the active
+    OutputSink only when the buffer fills, on flushOutput(), or when the thread exits.
+    Appending never takes a lock or allocates. Numbers are formatted into a stack buffer.
+
+    Sinks:
+    - ConsoleSink: Writes to stdout (the default).
+    - NullSink: Discards everything, for benchmarking the code around the output.
+
+    Text from different threads is interleaved a chunk at a time. When the buffer fills, only
+    its complete lines are handed over and an unfinished line stays behind, so a line is never
+    split unless it is larger than the buffer.
+*/
+
+#pragma once
+
+// Include necessary headers
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+// Destination for buffered output
+class OutputSink {
+public:
+    virtual void write(const char* data, size_t size) = 0;
+    virtual void flush() {}
+    virtual ~OutputSink() {}
+};
+
+// ConsoleSink: Writes to stdout
+class ConsoleSink : public OutputSink {
+public:
+    void write(const char* data, size_t size) override {
+        std::fwrite(data, 1, size, stdout);
+    }
+    void flush() override {
+        std::fflush(stdout);
+    }
+};
+
+// NullSink: Discards all output
+class NullSink : public OutputSink {
+public:
+    void write(const char*, size_t) override {}
+};
+
+inline ConsoleSink& consoleSink() {
+    static ConsoleSink instance;
+    return instance;
+}
+
+inline NullSink& nullSink() {
+    static NullSink instance;
+    return instance;
+}
+
+inline std::atomic<OutputSink*>& activeSink() {
+    static std::atomic<OutputSink*> sink(&consoleSink());
+    return sink;
+}
+
+// OutputWriter: Per-thread buffer in front of the active sink
+class OutputWriter {
+private:
+    static const size_t capacity = 16 * 1024;
+    char buffer[capacity];
+    size_t used;
+
+    template <typename Unsigned>
+    OutputWriter& writeUnsigned(Unsigned value, bool negative) {
+        char digits[24];
+        char* end = digits + sizeof(digits);
+        char* begin = end;
+        do {
+            *--begin = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        if (negative) {
+            *--begin = '-';
+        }
+        return write(begin, static_cast<size_t>(end - begin));
+    }
+
+public:
+    OutputWriter() : used(0) {}
+    ~OutputWriter() { flush(); } // Thread exit hands over whatever is left
+
+    OutputWriter(const OutputWriter&) = delete;
+    OutputWriter& operator=(const OutputWriter&) = delete;
+
+    // Hand over the complete lines in the buffer and keep the unfinished one. A full buffer
+    // without a newline holds part of an oversized line and is handed over as it is.
+    void drainLines() {
+        size_t end = used;
+        while (end > 0 && buffer[end - 1] != '\n') {
+            --end;
+        }
+        if (end == 0) {
+            end = used;
+        }
+        activeSink().load(std::memory_order_acquire)->write(buffer, end);
+        std::memmove(buffer, buffer + end, used - end);
+        used -= end;
+    }
+
+    OutputWriter& write(const char* data, size_t size) {
+        while (used + size > capacity) {
+            size_t room = capacity - used;
+            std::memcpy(buffer + used, data, room);
+            used = capacity;
+            data += room;
+            size -= room;
+            drainLines();
+        }
+        std::memcpy(buffer + used, data, size);
+        used += size;
+        return *this;
+    }
+
+    // Hand buffered text to the sink without forcing the sink itself to flush
+    void drain() {
+        if (used != 0) {
+            activeSink().load(std::memory_order_acquire)->write(buffer, used);
+            used = 0;
+        }
+    }
+
+    void flush() {
+        drain();
+        activeSink().load(std::memory_order_acquire)->flush();
+    }
+
+    OutputWriter& spaces(size_t count) {
+        static const char blanks[] = "                                ";
+        while (count > 0) {
+            size_t chunk = count < sizeof(blanks) - 1 ? count : sizeof(blanks) - 1;
+            write(blanks, chunk);
+            count -= chunk;
+        }
+        return *this;
+    }
+
+    OutputWriter& operator<<(const char* text) { return write(text, std::strlen(text)); }
+    OutputWriter& operator<<(const std::string& text) { return write(text.data(), text.size()); }
+    OutputWriter& operator<<(char c) { return write(&c, 1); }
+
+    // Like std::cout, the other character types (including uint8_t and int8_t) print as characters
+    OutputWriter& operator<<(signed char c) { return *this << static_cast<char>(c); }
+    OutputWriter& operator<<(unsigned char c) { return *this << static_cast<char>(c); }
+
+    template <typename Integer,
+              typename std::enable_if<std::is_integral<Integer>::value && !std::is_same<Integer, char>::value
+                                      && !std::is_same<Integer, signed char>::value
+                                      && !std::is_same<Integer, unsigned char>::value
+                                      && !std::is_same<Integer, bool>::value, int>::type = 0>
+    OutputWriter& operator<<(Integer value) {
+        typedef typename std::make_unsigned<Integer>::type Unsigned;
+        if (value < 0) {
+            return writeUnsigned(static_cast<Unsigned>(0 - static_cast<Unsigned>(value)), true);
+        }
+        return writeUnsigned(static_cast<Unsigned>(value), false);
+    }
+
+    OutputWriter& operator<<(bool value) { return *this << (value ? '1' : '0'); }
+
+    OutputWriter& operator<<(double value) {
+        char text[32];
+        int length = std::snprintf(text, sizeof(text), "%g", value); // Same default format as std::cout
+        return write(text, length > 0 ? static_cast<size_t>(length) : 0);
+    }
+};
+
+// The calling thread's writer
+inline OutputWriter& output() {
+    thread_local OutputWriter writer;
+    return writer;
+}
+
+// Flush the calling thread's buffer and the sink
+inline void flushOutput() {
+    output().flush();
+}
+
+// Route subsequent output to sink; the calling thread's pending text goes to the previous sink first
+inline void setOutputSink(OutputSink& sink) {
+    output().flush();
+    activeSink().store(&sink, std::memory_order_release);
+}
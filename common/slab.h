@@ -0,0 +1,127 @@
+/*
+    Slab shared by the factory examples.
+
+    A Slab<Base> owns a block of objects of one concrete type, constructed back to back in a
+    single allocation and used through their common Base. Iterating a slab walks memory in order
+    and calls the same override for every element, which keeps caches and the branch predictor
+    happy. Objects are destroyed together when the slab goes away.
+*/
+
+#pragma once
+
+// Include necessary headers
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <iterator>
+#include <type_traits>
+
+template <typename Base>
+class Slab {
+private:
+    void* storage;
+    Base* first;       // Base subobject of the first element
+    size_t count;
+    size_t stride;     // sizeof the concrete type
+    void (*destroy)(void* storage, size_t count);
+
+    template <typename Product>
+    static void destroyAll(void* storage, size_t count) {
+        Product* products = static_cast<Product*>(storage);
+        for (size_t i = count; i-- > 0;) {
+            products[i].~Product();
+        }
+    }
+
+public:
+    // Iterates the elements as Base&
+    class Iterator {
+    private:
+        char* position;
+        size_t stride;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Base;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Base*;
+        using reference = Base&;
+
+        Iterator(char* at, size_t step) : position(at), stride(step) {}
+        Base& operator*() const { return *reinterpret_cast<Base*>(position); }
+        Base* operator->() const { return reinterpret_cast<Base*>(position); }
+        Iterator& operator++() { position += stride; return *this; }
+        Iterator operator++(int) { Iterator before = *this; position += stride; return before; }
+        bool operator==(const Iterator& other) const { return position == other.position; }
+        bool operator!=(const Iterator& other) const { return position != other.position; }
+    };
+
+    Slab() : storage(nullptr), first(nullptr), count(0), stride(0), destroy(nullptr) {}
+
+    // Construct count default-initialized Products in one allocation
+    template <typename Product>
+    static Slab make(size_t count) {
+        static_assert(std::is_base_of<Base, Product>::value, "Product must derive from Base");
+        static_assert(alignof(Product) <= alignof(std::max_align_t), "Over-aligned products are not supported");
+        Slab slab;
+        if (count == 0) {
+            return slab;
+        }
+        Product* products = static_cast<Product*>(::operator new(sizeof(Product) * count));
+        size_t constructed = 0;
+        try {
+            for (; constructed < count; ++constructed) {
+                new (products + constructed) Product();
+            }
+        }
+        catch (...) {
+            destroyAll<Product>(products, constructed);
+            ::operator delete(products);
+            throw;
+        }
+        slab.storage = products;
+        slab.first = static_cast<Base*>(products);
+        slab.count = count;
+        slab.stride = sizeof(Product);
+        slab.destroy = &destroyAll<Product>;
+        return slab;
+    }
+
+    ~Slab() {
+        if (storage != nullptr) {
+            destroy(storage, count);
+            ::operator delete(storage);
+        }
+    }
+
+    Slab(Slab&& other) noexcept
+        : storage(other.storage), first(other.first), count(other.count), stride(other.stride), destroy(other.destroy) {
+        other.storage = nullptr;
+        other.first = nullptr;
+        other.count = 0;
+    }
+
+    Slab& operator=(Slab&& other) noexcept {
+        if (this != &other) {
+            Slab discarded(std::move(*this));
+            std::swap(storage, other.storage);
+            std::swap(first, other.first);
+            std::swap(count, other.count);
+            std::swap(stride, other.stride);
+            std::swap(destroy, other.destroy);
+        }
+        return *this;
+    }
+
+    Slab(const Slab&) = delete;
+    Slab& operator=(const Slab&) = delete;
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    Base& operator[](size_t index) const {
+        return *reinterpret_cast<Base*>(reinterpret_cast<char*>(first) + index * stride);
+    }
+
+    Iterator begin() const { return Iterator(reinterpret_cast<char*>(first), stride); }
+    Iterator end() const { return Iterator(reinterpret_cast<char*>(first) + count * stride, stride); }
+};
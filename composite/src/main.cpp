@@ -1,7 +1,7 @@
 /*
     Composite: Allows for treating individual objects and compositions of objects uniformly.
                It is particularly useful when dealing with hierarchical structures like
-               trees. This pattern allows clients to work with complex structures without 
+               trees. This pattern allows clients to work with complex structures without
                needing to differentiate between individual objects and compositions.
 
                Components:
@@ -10,29 +10,197 @@
                - Leaf (Concrete class): Represents an individual object that has no children.
                - Composite (Concrete class): Represents a complex object that can contain
                                              children (other Components).
+
+               FlatFileSystem is a companion representation of a built composite: the tree is
+               flattened into pre-order arrays with subtree sizes, so aggregate queries become
+               linear scans that can be split across threads.
+
+               FileSystemScanner populates the composite from a real directory tree with a
+               work-stealing parallel walk, and caches per-directory listings and aggregated
+               sizes so a re-scan of a mostly unchanged tree only re-reads what changed.
 */
 
 // Include necessary headers
-#include <iostream>
+#include "../../common/output_sink.h"
 #include <vector>
 #include <memory>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+#include <filesystem>
+#include <fstream>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#endif
+
+class FlatFileSystem;
 
  // Component: Abstract base class
 class FileSystemComponent {
 public:
     virtual void showDetails(int indent = 0) const = 0; // Pure virtual function
+    virtual uint64_t totalSize() const = 0;              // Sum of file sizes in this subtree
+    virtual size_t count() const = 0;                    // Number of nodes in this subtree
+    virtual const FileSystemComponent* find(const std::string& name) const = 0;
+    virtual void flattenInto(FlatFileSystem& flat, uint32_t depth) const = 0;
+    virtual const std::string& getName() const = 0;
     virtual ~FileSystemComponent() = default;
 };
 
+// FlatFileSystem: Pre-order arrays of a composite; node i's subtree is [i, i + subtreeSize[i])
+class FlatFileSystem {
+private:
+    std::vector<uint32_t> subtreeSizes; // Number of nodes in each node's subtree, including itself
+    std::vector<uint32_t> depths;
+    std::vector<uint64_t> sizes;        // File size, 0 for directories
+    std::vector<uint8_t> directoryFlags;
+    std::vector<uint32_t> nameOffsets;  // Names packed into one buffer; name i is [offset[i], offset[i+1])
+    std::string names;
+
+    // Run body(begin, end) over [first, last), split into contiguous chunks across threads
+    template <typename Body>
+    void forChunks(size_t first, size_t last, unsigned threadCount, Body body) const {
+        size_t total = last - first;
+        if (threadCount <= 1 || total < 65536) {
+            body(0, first, last);
+            return;
+        }
+        std::vector<std::thread> workers;
+        size_t chunk = (total + threadCount - 1) / threadCount;
+        for (unsigned t = 0; t < threadCount; ++t) {
+            size_t begin = first + t * chunk;
+            size_t end = std::min(last, begin + chunk);
+            if (begin >= end) {
+                break;
+            }
+            workers.emplace_back(body, t, begin, end);
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+public:
+    FlatFileSystem() : nameOffsets(1, 0) {}
+
+    // Append a node in pre-order and return its index; directories patch their size afterwards
+    size_t append(const std::string& name, uint64_t size, bool isDirectory, uint32_t depth) {
+        subtreeSizes.push_back(1);
+        depths.push_back(depth);
+        sizes.push_back(size);
+        directoryFlags.push_back(isDirectory ? 1 : 0);
+        names.append(name);
+        nameOffsets.push_back(static_cast<uint32_t>(names.size()));
+        return subtreeSizes.size() - 1;
+    }
+
+    void closeDirectory(size_t index) {
+        subtreeSizes[index] = static_cast<uint32_t>(subtreeSizes.size() - index);
+    }
+
+    size_t size() const { return subtreeSizes.size(); }
+
+    // Aggregate over node's subtree, optionally split across threads
+    uint64_t totalSize(size_t node = 0, unsigned threadCount = 1) const {
+        std::vector<uint64_t> partial(std::max(1u, threadCount), 0);
+        forChunks(node, node + subtreeSizes[node], threadCount, [&](unsigned t, size_t begin, size_t end) {
+            uint64_t sum = 0;
+            for (size_t i = begin; i < end; ++i) {
+                sum += sizes[i];
+            }
+            partial[t] = sum;
+        });
+        uint64_t total = 0;
+        for (uint64_t sum : partial) {
+            total += sum;
+        }
+        return total;
+    }
+
+    size_t count(size_t node = 0) const {
+        return subtreeSizes[node]; // Already known from the layout
+    }
+
+    size_t countFiles(size_t node = 0, unsigned threadCount = 1) const {
+        std::vector<size_t> partial(std::max(1u, threadCount), 0);
+        forChunks(node, node + subtreeSizes[node], threadCount, [&](unsigned t, size_t begin, size_t end) {
+            size_t files = 0;
+            for (size_t i = begin; i < end; ++i) {
+                files += directoryFlags[i] ^ 1;
+            }
+            partial[t] = files;
+        });
+        size_t total = 0;
+        for (size_t files : partial) {
+            total += files;
+        }
+        return total;
+    }
+
+    // Index of the first node (in pre-order) named name within node's subtree, or size() if absent
+    size_t find(const std::string& name, size_t node = 0, unsigned threadCount = 1) const {
+        std::vector<size_t> partial(std::max(1u, threadCount), size());
+        forChunks(node, node + subtreeSizes[node], threadCount, [&](unsigned t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                uint32_t length = nameOffsets[i + 1] - nameOffsets[i];
+                if (length == name.size() && names.compare(nameOffsets[i], length, name) == 0) {
+                    partial[t] = i;
+                    return;
+                }
+            }
+        });
+        return *std::min_element(partial.begin(), partial.end());
+    }
+
+    std::string nameOf(size_t node) const {
+        return names.substr(nameOffsets[node], nameOffsets[node + 1] - nameOffsets[node]);
+    }
+
+    void showDetails() const {
+        for (size_t i = 0; i < size(); ++i) {
+            output().spaces(depths[i] * 2) << (directoryFlags[i] ? "Directory: " : "File: ");
+            output().write(names.data() + nameOffsets[i], nameOffsets[i + 1] - nameOffsets[i]) << '\n';
+        }
+    }
+};
+
 // Leaf: Represents individual file
 class File : public FileSystemComponent {
 private:
     std::string name;
+    uint64_t size;
+    int64_t modifiedTime; // Nanoseconds since the filesystem clock's epoch, 0 if unknown
 public:
-    File(const std::string& name) : name(name) {}
+    File(const std::string& name, uint64_t size = 0, int64_t modifiedTime = 0)
+        : name(name), size(size), modifiedTime(modifiedTime) {}
+    uint64_t getSize() const { return size; }
+    int64_t getModifiedTime() const { return modifiedTime; }
     void showDetails(int indent = 0) const override {
-        std::cout << std::string(indent, ' ') << "File: " << name << '\n';
+        output().spaces(indent) << "File: " << name << '\n';
     }
+    uint64_t totalSize() const override { return size; }
+    size_t count() const override { return 1; }
+    const FileSystemComponent* find(const std::string& target) const override {
+        return name == target ? this : nullptr;
+    }
+    void flattenInto(FlatFileSystem& flat, uint32_t depth) const override {
+        flat.append(name, size, false, depth);
+    }
+    const std::string& getName() const override { return name; }
 };
 
 // Composite: Represents a directory that can contain files or other directories
@@ -48,14 +216,455 @@ public:
     }
 
     void showDetails(int indent = 0) const override {
-        std::cout << std::string(indent, ' ') << "Directory: " << name << '\n';
+        output().spaces(indent) << "Directory: " << name << '\n';
         for (const auto& child : children) {
             child->showDetails(indent + 2); // Indent children for hierarchy visualization
         }
     }
+
+    uint64_t totalSize() const override {
+        uint64_t total = 0;
+        for (const auto& child : children) {
+            total += child->totalSize();
+        }
+        return total;
+    }
+
+    size_t count() const override {
+        size_t total = 1;
+        for (const auto& child : children) {
+            total += child->count();
+        }
+        return total;
+    }
+
+    const FileSystemComponent* find(const std::string& target) const override {
+        if (name == target) {
+            return this;
+        }
+        for (const auto& child : children) {
+            if (const FileSystemComponent* found = child->find(target)) {
+                return found;
+            }
+        }
+        return nullptr;
+    }
+
+    void flattenInto(FlatFileSystem& flat, uint32_t depth) const override {
+        size_t index = flat.append(name, 0, true, depth);
+        for (const auto& child : children) {
+            child->flattenInto(flat, depth + 1);
+        }
+        flat.closeDirectory(index);
+    }
+
+    const std::string& getName() const override { return name; }
+};
+
+// Flatten a composite into its pre-order array form
+FlatFileSystem flatten(const FileSystemComponent& root) {
+    FlatFileSystem flat;
+    root.flattenInto(flat, 0);
+    return flat;
+}
+
+// FileSystemScanner: Loads a real directory tree into the composite
+class FileSystemScanner {
+public:
+    struct Options {
+        unsigned threadCount = 0;        // 0 = one worker per hardware thread
+        bool trustDirectoryMtime = true; // Reuse a directory's listing while its mtime is unchanged;
+                                         // files rewritten in place are then not re-stat'ed
+    };
+
+private:
+    struct Entry {
+        std::string name;
+        uint64_t size;
+        int64_t modifiedTime;
+        bool isDirectory;
+    };
+
+    // Cached state of one scanned directory, keyed by its path
+    struct DirectoryRecord {
+        int64_t modifiedTime = -1;
+        std::vector<std::shared_ptr<FileSystemComponent>> files;
+        std::vector<std::string> subdirectories; // Full paths
+        uint64_t filesSize = 0;
+        uint64_t subtreeSize = 0;
+        bool relisted = false;                   // Listing re-read during the current scan
+        uint64_t generation = 0;                 // Last scan that visited this directory
+        std::shared_ptr<Directory> node;
+        std::vector<std::shared_ptr<FileSystemComponent>> nodeChildren; // Subdirectory nodes node was built with
+    };
+
+    // Per-worker task deque: owners pop from the back, thieves steal from the front
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<std::string> paths;
+    };
+
+    Options options;
+    std::mutex recordsMutex;
+    std::unordered_map<std::string, std::unique_ptr<DirectoryRecord>> records;
+    uint64_t generation;
+    std::atomic<size_t> listedDirectories;
+
+    static std::string baseName(const std::string& path) {
+        size_t slash = path.find_last_of("/\\");
+        return slash == std::string::npos ? path : path.substr(slash + 1);
+    }
+
+#ifdef __linux__
+    static bool directoryModifiedTime(const std::string& path, int64_t& modifiedTime) {
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0) {
+            return false;
+        }
+        modifiedTime = int64_t(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+        return true;
+    }
+
+    // Batch-read entries with getdents64 and stat them relative to the open directory
+    static bool readDirectory(const std::string& path, std::vector<Entry>& entries) {
+        int fd = open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        alignas(struct dirent64) char buffer[64 * 1024];
+        while (true) {
+            long bytes = syscall(SYS_getdents64, fd, buffer, sizeof(buffer));
+            if (bytes <= 0) {
+                break;
+            }
+            for (long offset = 0; offset < bytes;) {
+                const struct dirent64* entry = reinterpret_cast<const struct dirent64*>(buffer + offset);
+                offset += entry->d_reclen;
+                const char* name = entry->d_name;
+                if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+                    continue;
+                }
+                struct stat info;
+                if (fstatat(fd, name, &info, AT_SYMLINK_NOFOLLOW) != 0) {
+                    continue; // Removed while scanning
+                }
+                entries.push_back(Entry{ name, static_cast<uint64_t>(info.st_size),
+                    int64_t(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec, S_ISDIR(info.st_mode) });
+            }
+        }
+        close(fd);
+        return true;
+    }
+#else
+    static bool directoryModifiedTime(const std::string& path, int64_t& modifiedTime) {
+        std::error_code error;
+        auto time = std::filesystem::last_write_time(path, error);
+        if (error) {
+            return false;
+        }
+        modifiedTime = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+        return true;
+    }
+
+    static bool readDirectory(const std::string& path, std::vector<Entry>& entries) {
+        std::error_code error;
+        std::filesystem::directory_iterator it(path, error);
+        if (error) {
+            return false;
+        }
+        for (const auto& entry : it) {
+            // Each query gets its own error code, so a later success cannot hide an earlier failure
+            std::error_code statusError, sizeError, timeError;
+            bool isDirectory = entry.symlink_status(statusError).type() == std::filesystem::file_type::directory;
+            uint64_t size = isDirectory || statusError ? 0 : entry.file_size(sizeError);
+            auto time = entry.last_write_time(timeError);
+            if (statusError || sizeError || timeError) {
+                continue; // Removed while scanning, as on Linux
+            }
+            entries.push_back(Entry{ entry.path().filename().string(), size,
+                std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count(), isDirectory });
+        }
+        return true;
+    }
+#endif
+
+    DirectoryRecord& recordFor(const std::string& path) {
+        std::lock_guard<std::mutex> lock(recordsMutex);
+        std::unique_ptr<DirectoryRecord>& record = records[path];
+        if (!record) {
+            record.reset(new DirectoryRecord());
+        }
+        return *record; // Records are heap-allocated, so the reference survives rehashing
+    }
+
+    // Refresh one directory's record and return its subdirectories for the walk
+    const std::vector<std::string>& visit(const std::string& path) {
+        DirectoryRecord& record = recordFor(path);
+        record.generation = generation;
+        record.relisted = false;
+
+        int64_t modifiedTime = -1;
+        if (!directoryModifiedTime(path, modifiedTime)) {
+            record = DirectoryRecord(); // Vanished: treat as empty
+            record.generation = generation;
+            record.relisted = true;
+            return record.subdirectories;
+        }
+        if (options.trustDirectoryMtime && record.modifiedTime == modifiedTime) {
+            return record.subdirectories; // Listing unchanged
+        }
+
+        std::vector<Entry> entries;
+        bool listed = readDirectory(path, entries);
+        record.files.clear();
+        record.subdirectories.clear();
+        record.filesSize = 0;
+        for (Entry& entry : entries) {
+            if (entry.isDirectory) {
+                record.subdirectories.push_back(path + "/" + entry.name);
+            }
+            else {
+                record.filesSize += entry.size;
+                record.files.push_back(std::make_shared<File>(entry.name, entry.size, entry.modifiedTime));
+            }
+        }
+        record.modifiedTime = listed ? modifiedTime : -1; // A failed read is retried on the next scan
+        record.relisted = true;
+        listedDirectories.fetch_add(1, std::memory_order_relaxed);
+        return record.subdirectories;
+    }
+
+    // Work-stealing parallel walk: every directory is one task that may spawn more
+    void walk(const std::string& root) {
+        unsigned threadCount = options.threadCount ? options.threadCount : std::max(1u, std::thread::hardware_concurrency());
+        std::vector<WorkQueue> queues(threadCount);
+        std::atomic<size_t> pending(1);
+        queues[0].paths.push_back(root);
+
+        auto take = [&](unsigned self, std::string& path) {
+            for (unsigned k = 0; k < threadCount; ++k) {
+                WorkQueue& queue = queues[(self + k) % threadCount];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (!queue.paths.empty()) {
+                    if (k == 0) {
+                        path = std::move(queue.paths.back()); // Own work: depth-first
+                        queue.paths.pop_back();
+                    }
+                    else {
+                        path = std::move(queue.paths.front()); // Steal the oldest, largest subtrees
+                        queue.paths.pop_front();
+                    }
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        auto worker = [&](unsigned self) {
+            std::string path;
+            while (pending.load(std::memory_order_acquire) > 0) {
+                if (!take(self, path)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                const std::vector<std::string>& subdirectories = visit(path);
+                pending.fetch_add(subdirectories.size(), std::memory_order_relaxed);
+                {
+                    std::lock_guard<std::mutex> lock(queues[self].mutex);
+                    queues[self].paths.insert(queues[self].paths.end(), subdirectories.begin(), subdirectories.end());
+                }
+                pending.fetch_sub(1, std::memory_order_release);
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned t = 1; t < threadCount; ++t) {
+            workers.emplace_back(worker, t);
+        }
+        worker(0);
+        for (auto& thread : workers) {
+            thread.join();
+        }
+    }
+
+    // Bottom-up pass: rebuild only the directory nodes whose contents or subtrees changed
+    std::shared_ptr<Directory> assemble(const std::string& path) {
+        DirectoryRecord& record = *records[path];
+        std::vector<std::shared_ptr<FileSystemComponent>> children;
+        children.reserve(record.subdirectories.size());
+        record.subtreeSize = record.filesSize;
+        for (const std::string& subdirectory : record.subdirectories) {
+            children.push_back(assemble(subdirectory));
+            record.subtreeSize += records[subdirectory]->subtreeSize;
+        }
+
+        if (!record.node || record.relisted || children != record.nodeChildren) {
+            record.node = std::make_shared<Directory>(baseName(path));
+            for (const auto& file : record.files) {
+                record.node->add(file);
+            }
+            for (const auto& child : children) {
+                record.node->add(child);
+            }
+            record.nodeChildren = std::move(children);
+        }
+        return record.node;
+    }
+
+public:
+    FileSystemScanner() : FileSystemScanner(Options()) {}
+    FileSystemScanner(const Options& scanOptions) : options(scanOptions), generation(0), listedDirectories(0) {}
+
+    // Scan root and return it as a composite; repeated scans reuse unchanged parts
+    std::shared_ptr<Directory> scan(const std::string& root) {
+        ++generation;
+        listedDirectories = 0;
+        walk(root);
+        for (auto it = records.begin(); it != records.end();) {
+            it = it->second->generation == generation ? std::next(it) : records.erase(it); // Drop removed directories
+        }
+        return assemble(root);
+    }
+
+    // Aggregated size of a scanned directory, maintained incrementally across scans
+    uint64_t subtreeSize(const std::string& path) const {
+        auto found = records.find(path);
+        return found == records.end() ? 0 : found->second->subtreeSize;
+    }
+
+    size_t directoriesListedLastScan() const { return listedDirectories.load(); }
 };
 
-int main() {
+// Build a synthetic tree: directories of fanout children, files at the bottom level
+std::shared_ptr<Directory> buildTree(int depth, int fanout, uint64_t& seed) {
+    auto dir = std::make_shared<Directory>("dir" + std::to_string(seed % 100000));
+    for (int i = 0; i < fanout; ++i) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        if (depth > 1) {
+            dir->add(buildTree(depth - 1, fanout, seed));
+        }
+        else {
+            dir->add(std::make_shared<File>("file" + std::to_string(seed >> 40), (seed >> 33) % 65536));
+        }
+    }
+    return dir;
+}
+
+// Benchmark: aggregate queries on the pointer tree vs the flattened tree
+void benchmarkFlatTree() {
+    using Clock = std::chrono::steady_clock;
+    auto milliseconds = [](Clock::duration d) {
+        return std::chrono::duration<double, std::milli>(d).count();
+    };
+
+    uint64_t seed = 42;
+    auto root = buildTree(6, 12, seed); // About 3.2M nodes
+    FlatFileSystem flat = flatten(*root);
+    const std::string missing = "no-such-file";
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+
+    auto start = Clock::now();
+    uint64_t pointerSize = root->totalSize();
+    size_t pointerCount = root->count();
+    bool pointerFound = root->find(missing) != nullptr;
+    double pointerTime = milliseconds(Clock::now() - start);
+
+    start = Clock::now();
+    uint64_t flatSize = flat.totalSize();
+    size_t flatFiles = flat.countFiles();
+    bool flatFound = flat.find(missing) != flat.size();
+    double flatTime = milliseconds(Clock::now() - start);
+
+    start = Clock::now();
+    uint64_t parallelSize = flat.totalSize(0, threads);
+    size_t parallelFiles = flat.countFiles(0, threads);
+    bool parallelFound = flat.find(missing, 0, threads) != flat.size();
+    double parallelTime = milliseconds(Clock::now() - start);
+
+    output() << "Tree of " << pointerCount << " nodes (" << flatFiles << " files), total size " << pointerSize << "\n";
+    output() << "  pointer tree: " << pointerTime << " ms\n";
+    output() << "  flat tree:    " << flatTime << " ms\n";
+    output() << "  flat tree, " << threads << " thread(s): " << parallelTime << " ms\n";
+    if (pointerSize != flatSize || flatSize != parallelSize || flatFiles != parallelFiles
+        || pointerFound || flatFound || parallelFound) {
+        output() << "  result mismatch!\n";
+    }
+    flushOutput();
+}
+
+// Create a new, uniquely named directory under the temp directory; never reuses an existing one
+std::filesystem::path createUniqueTempDirectory(const std::string& prefix) {
+    namespace fs = std::filesystem;
+    std::random_device entropy;
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        fs::path candidate = fs::temp_directory_path() / (prefix + std::to_string(entropy()) + std::to_string(entropy()));
+        if (fs::create_directory(candidate)) {
+            return candidate;
+        }
+    }
+    throw std::runtime_error("Cannot create a temporary directory");
+}
+
+// Benchmark: scan a generated tree of fileCount files, then re-scan it unchanged and after small edits
+void benchmarkScanner(size_t fileCount) {
+    using Clock = std::chrono::steady_clock;
+    auto milliseconds = [](Clock::duration d) {
+        return std::chrono::duration<double, std::milli>(d).count();
+    };
+    namespace fs = std::filesystem;
+
+    // Generate directories of 1000 files each, grouped 10 per parent directory
+    const size_t filesPerDirectory = 1000;
+    const std::string root = createUniqueTempDirectory("composite_scan_").string();
+    size_t directoryCount = (fileCount + filesPerDirectory - 1) / filesPerDirectory;
+    auto start = Clock::now();
+    for (size_t d = 0; d < directoryCount; ++d) {
+        std::string directory = root + "/group" + std::to_string(d / 10) + "/dir" + std::to_string(d);
+        fs::create_directories(directory);
+        for (size_t f = 0; f < filesPerDirectory && d * filesPerDirectory + f < fileCount; ++f) {
+            std::ofstream(directory + "/file" + std::to_string(f)) << std::string(f % 64, 'x');
+        }
+    }
+    output() << "Generated " << fileCount << " files in " << milliseconds(Clock::now() - start) << " ms\n";
+
+    FileSystemScanner scanner;
+    start = Clock::now();
+    auto tree = scanner.scan(root);
+    output() << "  full scan:      " << milliseconds(Clock::now() - start) << " ms, "
+             << tree->count() << " nodes, " << scanner.subtreeSize(root) << " bytes\n";
+
+    start = Clock::now();
+    tree = scanner.scan(root);
+    output() << "  unchanged scan: " << milliseconds(Clock::now() - start) << " ms, "
+             << scanner.directoriesListedLastScan() << " directories re-read\n";
+
+    for (size_t d = 0; d < directoryCount; d += std::max<size_t>(1, directoryCount / 10)) {
+        std::ofstream(root + "/group" + std::to_string(d / 10) + "/dir" + std::to_string(d) + "/added") << "new";
+    }
+    start = Clock::now();
+    tree = scanner.scan(root);
+    output() << "  after edits:    " << milliseconds(Clock::now() - start) << " ms, "
+             << scanner.directoriesListedLastScan() << " directories re-read, "
+             << scanner.subtreeSize(root) << " bytes (tree says " << tree->totalSize() << ")\n";
+
+    fs::remove_all(root);
+    flushOutput();
+}
+
+int main(int argc, char* argv[]) {
+    // Optional argument: number of files in the generated scanner benchmark tree
+    size_t scanFileCount = 20000;
+    if (argc > 1) {
+        char* end = nullptr;
+        unsigned long long count = std::strtoull(argv[1], &end, 10);
+        if (end == argv[1] || *end != '\0' || count == 0) {
+            output() << "Usage: " << argv[0] << " [scanner benchmark file count, default 20000]\n";
+            flushOutput();
+            return 1;
+        }
+        scanFileCount = static_cast<size_t>(count);
+    }
+
     // Creating files
     auto file1 = std::make_shared<File>("file1.txt");
     auto file2 = std::make_shared<File>("file2.txt");
@@ -72,5 +681,11 @@ int main() {
     // Displaying the structure
     dir1->showDetails();
 
+    // The same structure in flattened form
+    flatten(*dir1).showDetails();
+
+    benchmarkFlatTree();
+    benchmarkScanner(scanFileCount);
+
     return 0;
-}
\ No newline at end of file
+}
@@ -14,10 +14,31 @@
                                            reference to a component object.
                Concrete Decorators: Extend functionality of the component by adding 
                                     extra behaviors.
+
+               Stacks that are fixed at build time can instead be composed from mixin
+               templates (Decorated<Core, A, B>), which the compiler inlines into one call.
+               Stacks composed at runtime can be flattened into a Pipeline, which lists the
+               chain's Stage decorators in one contiguous array and runs their added behaviours
+               in a loop; other decorators stay nested.
+               TimingDecorator instruments any Component with a sampled latency histogram.
 */
 
 // Include necessary headers
-#include <iostream>
+#include "../../common/output_sink.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 
 // Create the base Component interface
 class Component {
@@ -30,7 +51,7 @@ public:
 class ConcreteComponent : public Component {
 public:
     void operation() override {
-        std::cout << "ConcreteComponent: Base Operation\n";
+        output() << "ConcreteComponent: Base Operation\n";
     }
 };
 
@@ -43,52 +64,587 @@ public:
     void operation() override {
         component->operation(); // Delegate to the wrapped object
     }
+
+    Component* wrapped() const { return component; }
     virtual ~Decorator() {
         delete component; // Clean up dynamically allocated memory
     }
 };
 
+// Stage: Implemented by decorators whose only work is added after the wrapped call, so a Pipeline
+// can run that work on its own instead of through the nested calls
+class Stage {
+public:
+    virtual void addedBehavior() = 0;
+    virtual ~Stage() {}
+};
+
+// BatchStage: A stage that can also apply its behaviour to a batch of items in place
+class BatchStage : public Stage {
+public:
+    virtual void process(uint64_t* items, size_t count) = 0;
+};
+
 // Implement Concrete Decorators that extend functionality
-class ConcreteDecoratorA : public Decorator {
+class ConcreteDecoratorA : public Decorator, public Stage {
 public:
     ConcreteDecoratorA(Component* comp) : Decorator(comp) {}
     void operation() override {
         Decorator::operation(); // Call base operation
-        std::cout << "ConcreteDecoratorA: Added Behavior A\n";
+        addedBehavior();
+    }
+    void addedBehavior() override {
+        output() << "ConcreteDecoratorA: Added Behavior A\n";
     }
 };
 
-class ConcreteDecoratorB : public Decorator {
+class ConcreteDecoratorB : public Decorator, public Stage {
 public:
     ConcreteDecoratorB(Component* comp) : Decorator(comp) {}
     void operation() override {
         Decorator::operation(); // Call base operation
-        std::cout << "ConcreteDecoratorB: Added Behavior B\n";
+        addedBehavior();
+    }
+    void addedBehavior() override {
+        output() << "ConcreteDecoratorB: Added Behavior B\n";
+    }
+};
+
+// Cheap timestamp source: the CPU time-stamp counter on x86, steady_clock nanoseconds elsewhere
+inline uint64_t readTicks() {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// Ticks per nanosecond, measured once against steady_clock
+inline double ticksPerNanosecond() {
+    static const double rate = [] {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+        auto start = std::chrono::steady_clock::now();
+        uint64_t startTicks = readTicks();
+        while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(10)) {
+        }
+        uint64_t ticks = readTicks() - startTicks;
+        return ticks / std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+#else
+        return 1.0;
+#endif
+    }();
+    return rate;
+}
+
+// Point-in-time view of a LatencyHistogram
+struct LatencySnapshot {
+    uint64_t calls;   // Calls through the decorator (exact)
+    uint64_t samples; // Calls that were timed
+    double p50;       // Nanoseconds
+    double p99;
+    double p999;
+    double max;
+};
+
+// LatencyHistogram: Lock-free log-linear histogram (HDR-style); 16 sub-buckets per power of two
+// keep every recorded value within about 6% of its bucket's lower bound
+class LatencyHistogram {
+private:
+    static const int subBucketBits = 5;
+    static const size_t bucketCount = (64 - subBucketBits + 2) << (subBucketBits - 1);
+    std::atomic<uint64_t> buckets[bucketCount];
+
+    static int highestBit(uint64_t value) {
+#if defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return static_cast<int>(index);
+#elif defined(__GNUC__)
+        return 63 - __builtin_clzll(value);
+#else
+        int bit = 0;
+        while (value >>= 1) {
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+
+    static size_t bucketFor(uint64_t value) {
+        if (value < (uint64_t(1) << subBucketBits)) {
+            return static_cast<size_t>(value); // Small values are recorded exactly
+        }
+        int shift = highestBit(value) - (subBucketBits - 1);
+        return (static_cast<size_t>(shift) << (subBucketBits - 1)) + static_cast<size_t>(value >> shift);
+    }
+
+    static uint64_t lowerBound(size_t bucket) {
+        if (bucket < (size_t(1) << subBucketBits)) {
+            return bucket;
+        }
+        size_t shift = (bucket >> (subBucketBits - 1)) - 1;
+        return static_cast<uint64_t>(bucket - (shift << (subBucketBits - 1))) << shift;
+    }
+
+public:
+    LatencyHistogram() {
+        for (auto& bucket : buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void record(uint64_t value) {
+        buckets[bucketFor(value)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Fill the percentile fields of snapshot, converting recorded ticks with ticksPerUnit
+    void summarize(LatencySnapshot& snapshot, double ticksPerUnit) const {
+        uint64_t counts[bucketCount];
+        uint64_t total = 0;
+        for (size_t i = 0; i < bucketCount; ++i) {
+            counts[i] = buckets[i].load(std::memory_order_relaxed);
+            total += counts[i];
+        }
+        snapshot.samples = total;
+        snapshot.p50 = snapshot.p99 = snapshot.p999 = snapshot.max = 0;
+        const double quantiles[] = { 0.5, 0.99, 0.999 };
+        double* targets[] = { &snapshot.p50, &snapshot.p99, &snapshot.p999 };
+        uint64_t seen = 0;
+        int next = 0;
+        for (size_t i = 0; i < bucketCount && total != 0; ++i) {
+            seen += counts[i];
+            while (next < 3 && seen > 0 && seen >= quantiles[next] * total) {
+                *targets[next++] = lowerBound(i) / ticksPerUnit;
+            }
+            if (counts[i] != 0) {
+                snapshot.max = lowerBound(i) / ticksPerUnit;
+            }
+        }
+    }
+};
+
+// TimingDecorator: Wraps any Component and records the latency of sampled operation() calls.
+// Each thread counts its calls in its own slot of the instance, with a plain load and store rather
+// than a locked read-modify-write, and times one call in sampleInterval (a power of two) of its own.
+// snapshot() adds the slots up, so the count is exact. A thread finds its slot through a small
+// thread-local cache keyed by a never-reused instance id.
+class TimingDecorator : public Decorator {
+private:
+    // Written only by its thread; the padding keeps other threads' counters off its cache line
+    struct CallSlot {
+        std::atomic<uint64_t> calls;
+        char padding[64 - sizeof(std::atomic<uint64_t>)];
+        CallSlot() : calls(0) {}
+    };
+
+    struct CachedSlot {
+        uint64_t owner; // Instance id, 0 when empty
+        CallSlot* slot;
+    };
+    static const size_t cacheSize = 8; // Power of two; enough for the decorators one thread interleaves
+
+    static uint64_t nextId() {
+        static std::atomic<uint64_t> ids(1);
+        return ids.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t id;
+    uint32_t sampleInterval;
+    mutable std::mutex slotsMutex;
+    std::vector<std::unique_ptr<CallSlot>> slots; // One per thread that has called operation()
+    LatencyHistogram histogram;
+
+    CallSlot& slotForThisThread() {
+        thread_local CachedSlot cache[cacheSize] = {};
+        CachedSlot& cached = cache[id & (cacheSize - 1)];
+        if (cached.owner != id) {
+            std::lock_guard<std::mutex> lock(slotsMutex); // Once per thread and instance, or after eviction
+            slots.emplace_back(new CallSlot());
+            cached.owner = id;
+            cached.slot = slots.back().get();
+        }
+        return *cached.slot;
+    }
+
+public:
+    TimingDecorator(Component* comp, uint32_t interval = 1) : Decorator(comp), id(nextId()), sampleInterval(1) {
+        while (sampleInterval < interval) {
+            sampleInterval <<= 1; // Round up to a power of two
+        }
+    }
+
+    void operation() override {
+        CallSlot& slot = slotForThisThread();
+        uint64_t call = slot.calls.load(std::memory_order_relaxed);
+        slot.calls.store(call + 1, std::memory_order_relaxed); // Only this thread writes the slot
+        if ((call & (sampleInterval - 1)) != 0) {
+            Decorator::operation(); // Unsampled fast path
+            return;
+        }
+        uint64_t start = readTicks();
+        Decorator::operation();
+        uint64_t elapsed = readTicks() - start;
+        histogram.record(elapsed);
+    }
+
+    LatencySnapshot snapshot() const {
+        LatencySnapshot result;
+        result.calls = 0;
+        {
+            std::lock_guard<std::mutex> lock(slotsMutex);
+            for (const auto& slot : slots) {
+                result.calls += slot->calls.load(std::memory_order_relaxed);
+            }
+        }
+        histogram.summarize(result, ticksPerNanosecond());
+        return result;
     }
 };
 
+// Pipeline: Flattens an existing runtime decorator chain. The outer decorators that implement
+// Stage are listed innermost first in one contiguous array, and operation() runs the rest of the
+// chain and then each stage's added behaviour in a loop instead of through nested calls. Flattening
+// stops at the first decorator that is not a Stage (such as TimingDecorator): it and everything it
+// wraps stay nested and run as they would without the Pipeline.
+class Pipeline : public Component {
+private:
+    std::unique_ptr<Component> chain;  // Owns the whole chain, as the outermost decorator does
+    Component* core;                   // Innermost part that is still called through nesting
+    std::vector<Stage*> stages;        // Innermost stage first
+    std::vector<BatchStage*> batchStages; // The same stages when all of them can process batches
+public:
+    Pipeline(Component* outermost) : chain(outermost), core(outermost) {
+        while (Decorator* decorator = dynamic_cast<Decorator*>(core)) {
+            Stage* stage = dynamic_cast<Stage*>(decorator);
+            if (stage == nullptr) {
+                break;
+            }
+            stages.push_back(stage);
+            core = decorator->wrapped();
+        }
+        std::reverse(stages.begin(), stages.end());
+        for (Stage* stage : stages) {
+            if (BatchStage* batchStage = dynamic_cast<BatchStage*>(stage)) {
+                batchStages.push_back(batchStage);
+            }
+        }
+    }
+
+    void operation() override {
+        core->operation();
+        for (Stage* stage : stages) {
+            stage->addedBehavior();
+        }
+    }
+
+    size_t depth() const { return stages.size(); }
+
+    // Run items through every stage, batchSize items at a time, so each stage's code and the
+    // batch stay in cache while the stage processes it. Every decorator in the chain must be a
+    // BatchStage, since the rest has no batch form to run.
+    void process(uint64_t* items, size_t count, size_t batchSize = 1024) {
+        if (batchStages.size() != stages.size() || dynamic_cast<Decorator*>(core) != nullptr) {
+            throw std::logic_error("Pipeline::process needs a chain made only of batch stages");
+        }
+        for (size_t begin = 0; begin < count; begin += batchSize) {
+            size_t length = std::min(batchSize, count - begin);
+            for (BatchStage* stage : batchStages) {
+                stage->process(items + begin, length);
+            }
+        }
+    }
+};
+
+// Benchmark decorator: mixes every item with its own constants; adds nothing to operation()
+class ItemMixDecorator : public Decorator, public BatchStage {
+private:
+    uint64_t multiplier;
+    uint64_t increment;
+public:
+    ItemMixDecorator(Component* comp, uint64_t mul, uint64_t inc) : Decorator(comp), multiplier(mul), increment(inc) {}
+    void addedBehavior() override {}
+    void process(uint64_t* items, size_t count) override {
+        for (size_t i = 0; i < count; ++i) {
+            items[i] = items[i] * multiplier + increment;
+        }
+    }
+};
+
+// Benchmark: 10M items through 8 stages, one item at a time vs in batches
+void benchmarkPipeline() {
+    using Clock = std::chrono::steady_clock;
+    const size_t itemCount = 10000000;
+    const int stageCount = 8;
+
+    Component* chain = new ConcreteComponent();
+    for (int i = 0; i < stageCount; ++i) {
+        chain = new ItemMixDecorator(chain, 2 * i + 3, i + 1);
+    }
+    Pipeline pipeline(chain);
+
+    std::vector<uint64_t> items(itemCount);
+    for (size_t batchSize : { size_t(1), size_t(64), size_t(1024), size_t(16384), itemCount }) {
+        for (size_t i = 0; i < itemCount; ++i) {
+            items[i] = i;
+        }
+        auto start = Clock::now();
+        pipeline.process(items.data(), itemCount, batchSize);
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        output() << "Pipeline of " << stageCount << " stages, batch " << batchSize << ": "
+                 << itemCount / seconds / 1e6 << " M items/s (checksum " << items[itemCount - 1] % 1000 << ")\n";
+    }
+    flushOutput();
+}
+
+// Compile-time decorators: each layer is a mixin over the type it wraps, so a stack is a single
+// object with no heap allocation and no virtual hop per layer. Decorated<Core, A, B> is B<A<Core>>.
+template <typename Core, template <typename> class... Layers>
+struct DecoratedStack;
+
+template <typename Core>
+struct DecoratedStack<Core> {
+    using type = Core;
+};
+
+template <typename Core, template <typename> class First, template <typename> class... Rest>
+struct DecoratedStack<Core, First, Rest...> {
+    using type = typename DecoratedStack<First<Core>, Rest...>::type;
+};
+
+template <typename Core, template <typename> class... Layers>
+using Decorated = typename DecoratedStack<Core, Layers...>::type;
+
+// Static counterpart of ConcreteComponent
+class StaticComponent {
+public:
+    void operation() {
+        output() << "ConcreteComponent: Base Operation\n";
+    }
+};
+
+// Static counterparts of the concrete decorators
+template <typename Base>
+class StaticDecoratorA : public Base {
+public:
+    void operation() {
+        Base::operation(); // Resolved at compile time
+        output() << "ConcreteDecoratorA: Added Behavior A\n";
+    }
+};
+
+template <typename Base>
+class StaticDecoratorB : public Base {
+public:
+    void operation() {
+        Base::operation(); // Resolved at compile time
+        output() << "ConcreteDecoratorB: Added Behavior B\n";
+    }
+};
+
+// Exposes a compile-time stack through the dynamic Component interface (one virtual hop in total),
+// so it can still be wrapped by runtime decorators
+template <typename Stack>
+class ComponentStack : public Component {
+private:
+    Stack stack;
+public:
+    void operation() override {
+        stack.operation();
+    }
+};
+
+// Benchmark components: each layer mixes a shared state so calls cannot be optimized away
+class MixComponent : public Component {
+public:
+    uint64_t state = 1;
+    void operation() override {
+        state = state * 31 + 7;
+    }
+};
+
+class MixDecorator : public Decorator {
+private:
+    uint64_t& state;
+public:
+    MixDecorator(Component* comp, uint64_t& sharedState) : Decorator(comp), state(sharedState) {}
+    void operation() override {
+        Decorator::operation();
+        state = state * 31 + 7;
+    }
+};
+
+class StaticMixComponent {
+public:
+    uint64_t state = 1;
+    void operation() {
+        state = state * 31 + 7;
+    }
+};
+
+template <typename Base>
+class StaticMixDecorator : public Base {
+public:
+    void operation() {
+        Base::operation();
+        this->state = this->state * 31 + 7;
+    }
+};
+
+// Repeated<Core, Layer, N>: Core wrapped in N copies of Layer
+template <typename Core, template <typename> class Layer, int N>
+struct Repeated {
+    using type = Layer<typename Repeated<Core, Layer, N - 1>::type>;
+};
+
+template <typename Core, template <typename> class Layer>
+struct Repeated<Core, Layer, 0> {
+    using type = Core;
+};
+
+// Benchmark: call cost of a dynamic and a compile-time stack of Depth decorators
+template <int Depth>
+void benchmarkDepth() {
+    using Clock = std::chrono::steady_clock;
+    const int callCount = 10000000;
+
+    MixComponent* core = new MixComponent();
+    Component* dynamicStack = core;
+    for (int i = 0; i < Depth; ++i) {
+        dynamicStack = new MixDecorator(dynamicStack, core->state);
+    }
+    auto start = Clock::now();
+    for (int i = 0; i < callCount; ++i) {
+        dynamicStack->operation();
+    }
+    double dynamicNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / callCount;
+    uint64_t dynamicState = core->state;
+    delete dynamicStack;
+
+    typename Repeated<StaticMixComponent, StaticMixDecorator, Depth>::type staticStack;
+    start = Clock::now();
+    for (int i = 0; i < callCount; ++i) {
+        staticStack.operation();
+    }
+    double staticNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / callCount;
+
+    output() << "Depth " << Depth << ": dynamic " << dynamicNs << " ns/call, compile-time " << staticNs
+             << " ns/call" << (dynamicState == staticStack.state ? "" : " (state mismatch!)") << "\n";
+}
+
+void benchmarkDecoratorStacks() {
+    benchmarkDepth<1>();
+    benchmarkDepth<2>();
+    benchmarkDepth<4>();
+    benchmarkDepth<8>();
+    benchmarkDepth<16>();
+    flushOutput();
+}
+
+// Benchmark: overhead of the timing decorator at several sampling intervals
+void benchmarkTimingDecorator() {
+    using Clock = std::chrono::steady_clock;
+    const int callCount = 10000000;
+
+    std::unique_ptr<Component> bare(new MixComponent());
+    auto start = Clock::now();
+    for (int i = 0; i < callCount; ++i) {
+        bare->operation();
+    }
+    double bareNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / callCount;
+    output() << "Undecorated: " << bareNs << " ns/call\n";
+
+    for (uint32_t interval : { 1u, 64u, 1024u }) {
+        TimingDecorator timed(new MixComponent(), interval);
+        start = Clock::now();
+        for (int i = 0; i < callCount; ++i) {
+            timed.operation();
+        }
+        double timedNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / callCount;
+        LatencySnapshot snapshot = timed.snapshot();
+        output() << "Timed, 1 in " << interval << " sampled: " << timedNs << " ns/call (overhead "
+                 << timedNs - bareNs << " ns); calls " << snapshot.calls << ", samples " << snapshot.samples
+                 << ", p50 " << snapshot.p50 << " ns, p99 " << snapshot.p99 << " ns, p999 " << snapshot.p999 << " ns\n";
+    }
+
+    // Nested decorators count and sample independently
+    const int nestedCalls = 64000;
+    TimingDecorator* inner = new TimingDecorator(new MixComponent(), 64);
+    TimingDecorator outer(inner, 64);
+    for (int i = 0; i < nestedCalls; ++i) {
+        outer.operation();
+    }
+    LatencySnapshot outerSnapshot = outer.snapshot();
+    LatencySnapshot innerSnapshot = inner->snapshot();
+    const uint64_t expectedCalls = nestedCalls;
+    const uint64_t expectedSamples = nestedCalls / 64;
+    bool consistent = outerSnapshot.calls == expectedCalls && innerSnapshot.calls == expectedCalls
+                      && outerSnapshot.samples == expectedSamples && innerSnapshot.samples == expectedSamples;
+    output() << "Nested 64/64: outer calls " << outerSnapshot.calls << ", samples " << outerSnapshot.samples
+             << "; inner calls " << innerSnapshot.calls << ", samples " << innerSnapshot.samples
+             << (consistent ? "" : " (count mismatch!)") << "\n";
+    flushOutput();
+}
+
 // Demonstrate usage of the decorator pattern
 int main() {
     // Create a simple ConcreteComponent
     Component* simple = new ConcreteComponent();
-    std::cout << "Simple Component:\n";
+    output() << "Simple Component:\n";
     simple->operation();
-    std::cout << "\n";
+    output() << "\n";
 
     // Wrap the component with ConcreteDecoratorA
     Component* decoratedA = new ConcreteDecoratorA(simple);
-    std::cout << "Component with ConcreteDecoratorA:\n";
+    output() << "Component with ConcreteDecoratorA:\n";
     decoratedA->operation();
-    std::cout << "\n";
+    output() << "\n";
 
     // Further wrap it with ConcreteDecoratorB
     Component* decoratedB = new ConcreteDecoratorB(decoratedA);
-    std::cout << "Component with ConcreteDecoratorA and ConcreteDecoratorB:\n";
+    output() << "Component with ConcreteDecoratorA and ConcreteDecoratorB:\n";
     decoratedB->operation();
-    std::cout << "\n";
+    output() << "\n";
 
     // Clean up
     delete decoratedB; // This will also delete decoratedA and simple
 
+    // The same stack composed at compile time
+    Decorated<StaticComponent, StaticDecoratorA, StaticDecoratorB> staticStack;
+    output() << "Compile-time stack of ConcreteDecoratorA and ConcreteDecoratorB:\n";
+    staticStack.operation();
+    output() << "\n";
+
+    // A compile-time stack can still be decorated further at runtime
+    Component* mixed = new ConcreteDecoratorB(new ComponentStack<Decorated<StaticComponent, StaticDecoratorA>>());
+    output() << "Compile-time stack wrapped by a runtime ConcreteDecoratorB:\n";
+    mixed->operation();
+    output() << "\n";
+    delete mixed;
+
+    // The same runtime stack flattened into a pipeline
+    Pipeline pipeline(new ConcreteDecoratorB(new ConcreteDecoratorA(new ConcreteComponent())));
+    output() << "Flattened pipeline of ConcreteDecoratorA and ConcreteDecoratorB:\n";
+    pipeline.operation();
+    output() << "\n";
+
+    // Instrument the decorated component without changing it
+    TimingDecorator timed(new ConcreteDecoratorA(new ConcreteComponent()));
+    output() << "Timed ConcreteDecoratorA:\n";
+    timed.operation();
+    LatencySnapshot snapshot = timed.snapshot();
+    output() << "Calls: " << snapshot.calls << ", p50: " << snapshot.p50 << " ns\n\n";
+
+    // Flattening stops at a decorator that is not a Stage; the timed part keeps its nested call
+    TimingDecorator* timedInner = new TimingDecorator(new ConcreteDecoratorA(new ConcreteComponent()));
+    Pipeline partlyFlat(new ConcreteDecoratorB(timedInner));
+    output() << "Pipeline of ConcreteDecoratorB over a timed ConcreteDecoratorA (" << partlyFlat.depth() << " stage):\n";
+    partlyFlat.operation();
+    output() << "Timed calls: " << timedInner->snapshot().calls << "\n\n";
+
+    benchmarkDecoratorStacks();
+    benchmarkPipeline();
+    benchmarkTimingDecorator();
+
     return 0;
 }
\ No newline at end of file
@@ -3,65 +3,198 @@
             making it easier to use. Instead of interacting with multiple components 
             of a system individually, the Facade acts as a single entry point
             that abstracts away the complexities.
+
+            The facade refers to its subsystems rather than owning copies. It describes
+            startup and shutdown as a dependency graph of steps and runs independent steps
+            concurrently, so startup takes as long as the slowest chain of steps rather than
+            the sum of all of them. The async variants return a future.
 */
 
 // Include necessary headers
-#include <iostream>
+#include "../../common/output_sink.h"
+#include <string>
+#include <vector>
+#include <functional>
+#include <future>
+#include <thread>
+#include <chrono>
+
+// Simulated slow initialization, shared by the subsystems
+class SlowStartup {
+protected:
+    std::chrono::milliseconds startupDelay;
+    explicit SlowStartup(std::chrono::milliseconds delay) : startupDelay(delay) {}
+    void warmUp() const {
+        if (startupDelay.count() > 0) {
+            std::this_thread::sleep_for(startupDelay);
+        }
+    }
+};
 
 // Subsystem 1: Amplifier
-class Amplifier {
+class Amplifier : SlowStartup {
 public:
-    void on() { std::cout << "Amplifier is turned ON.\n"; }
-    void off() { std::cout << "Amplifier is turned OFF.\n"; }
-    void setVolume(int level) { std::cout << "Amplifier volume set to " << level << "\n"; }
+    explicit Amplifier(std::chrono::milliseconds delay = std::chrono::milliseconds(0)) : SlowStartup(delay) {}
+    void on() { warmUp(); output() << "Amplifier is turned ON.\n"; }
+    void off() { output() << "Amplifier is turned OFF.\n"; }
+    void setVolume(int level) { output() << "Amplifier volume set to " << level << "\n"; }
 };
 
 // Subsystem 2: DVD Player
-class DVDPlayer {
+class DVDPlayer : SlowStartup {
 public:
-    void on() { std::cout << "DVD Player is turned ON.\n"; }
-    void off() { std::cout << "DVD Player is turned OFF.\n"; }
-    void play(std::string movie) { std::cout << "Playing movie: " << movie << "\n"; }
+    explicit DVDPlayer(std::chrono::milliseconds delay = std::chrono::milliseconds(0)) : SlowStartup(delay) {}
+    void on() { warmUp(); output() << "DVD Player is turned ON.\n"; }
+    void off() { output() << "DVD Player is turned OFF.\n"; }
+    void play(const std::string& movie) { output() << "Playing movie: " << movie << "\n"; }
 };
 
 // Subsystem 3: Projector
-class Projector {
+class Projector : SlowStartup {
+public:
+    explicit Projector(std::chrono::milliseconds delay = std::chrono::milliseconds(0)) : SlowStartup(delay) {}
+    void on() { warmUp(); output() << "Projector is turned ON.\n"; }
+    void off() { output() << "Projector is turned OFF.\n"; }
+    void wideScreenMode() { output() << "Projector set to widescreen mode.\n"; }
+};
+
+// StepGraph: Steps with dependencies, declared in an order where dependencies come first
+class StepGraph {
+private:
+    struct Step {
+        std::function<void()> action;
+        std::vector<size_t> dependencies;
+    };
+    std::vector<Step> steps;
+
 public:
-    void on() { std::cout << "Projector is turned ON.\n"; }
-    void off() { std::cout << "Projector is turned OFF.\n"; }
-    void wideScreenMode() { std::cout << "Projector set to widescreen mode.\n"; }
+    size_t add(std::function<void()> action, std::vector<size_t> dependencies = {}) {
+        steps.push_back(Step{ std::move(action), std::move(dependencies) });
+        return steps.size() - 1;
+    }
+
+    // Run steps one after another in declaration order
+    void runSequential() const {
+        for (const Step& step : steps) {
+            step.action();
+        }
+    }
+
+    // Start every step on its own task; each waits for its dependencies, so independent steps
+    // overlap. Rethrows the first failure, after all started steps have finished.
+    void runParallel() const {
+        std::vector<std::shared_future<void>> done;
+        done.reserve(steps.size());
+        for (const Step& step : steps) {
+            std::vector<std::shared_future<void>> waitFor;
+            for (size_t dependency : step.dependencies) {
+                waitFor.push_back(done[dependency]);
+            }
+            done.push_back(std::async(std::launch::async, [&step, waitFor] {
+                for (const auto& dependency : waitFor) {
+                    dependency.get(); // Propagates a dependency's failure
+                }
+                step.action();
+                flushOutput(); // Hand this task's output over before its thread is reused
+            }).share());
+        }
+        for (const auto& step : done) {
+            step.wait();
+        }
+        for (const auto& step : done) {
+            step.get();
+        }
+    }
 };
 
 // Facade: Home Theater System
 class HomeTheaterFacade {
 private:
-    Amplifier amp;
-    DVDPlayer dvd;
-    Projector projector;
+    Amplifier& amp;
+    DVDPlayer& dvd;
+    Projector& projector;
+    bool parallel;
+
+    void run(const StepGraph& graph) const {
+        if (parallel) {
+            graph.runParallel();
+        }
+        else {
+            graph.runSequential();
+        }
+    }
 
 public:
-    HomeTheaterFacade(Amplifier a, DVDPlayer d, Projector p) : amp(a), dvd(d), projector(p) {}
-
-    void watchMovie(std::string movie) {
-        std::cout << "\nPreparing to watch a movie...\n";
-        amp.on();
-        amp.setVolume(10);
-        dvd.on();
-        projector.on();
-        projector.wideScreenMode();
-        dvd.play(movie);
-        std::cout << "Enjoy your movie!\n";
+    // The subsystems must outlive the facade
+    HomeTheaterFacade(Amplifier& a, DVDPlayer& d, Projector& p, bool runParallel = true)
+        : amp(a), dvd(d), projector(p), parallel(runParallel) {}
+
+    void watchMovie(const std::string& movie) {
+        output() << "\nPreparing to watch a movie...\n";
+        flushOutput();
+        StepGraph startup;
+        size_t ampOn = startup.add([this] { amp.on(); });
+        size_t volume = startup.add([this] { amp.setVolume(10); }, { ampOn });
+        size_t dvdOn = startup.add([this] { dvd.on(); });
+        size_t projectorOn = startup.add([this] { projector.on(); });
+        size_t wideScreen = startup.add([this] { projector.wideScreenMode(); }, { projectorOn });
+        startup.add([this, &movie] { dvd.play(movie); }, { volume, dvdOn, wideScreen });
+        run(startup);
+        output() << "Enjoy your movie!\n";
+        flushOutput();
     }
 
     void endMovie() {
-        std::cout << "\nShutting down the home theater system...\n";
-        dvd.off();
-        projector.off();
-        amp.off();
-        std::cout << "Home theater system is off.\n";
+        output() << "\nShutting down the home theater system...\n";
+        flushOutput();
+        StepGraph shutdown;
+        size_t dvdOff = shutdown.add([this] { dvd.off(); });
+        size_t projectorOff = shutdown.add([this] { projector.off(); });
+        shutdown.add([this] { amp.off(); }, { dvdOff, projectorOff }); // Amplifier last
+        run(shutdown);
+        output() << "Home theater system is off.\n";
+        flushOutput();
+    }
+
+    // Async API: the future becomes ready when the movie is playing, or holds the failure
+    std::future<void> watchMovieAsync(std::string movie) {
+        return std::async(std::launch::async, [this, movie] { watchMovie(movie); });
+    }
+
+    std::future<void> endMovieAsync() {
+        return std::async(std::launch::async, [this] { endMovie(); });
     }
 };
 
+// Benchmark: startup latency with simulated subsystem delays, sequential versus parallel steps
+void benchmarkStartup() {
+    using Clock = std::chrono::steady_clock;
+    const int rounds = 5;
+    Amplifier amp(std::chrono::milliseconds(30));
+    DVDPlayer dvd(std::chrono::milliseconds(50));
+    Projector projector(std::chrono::milliseconds(80));
+
+    setOutputSink(nullSink());
+    HomeTheaterFacade sequential(amp, dvd, projector, false);
+    auto start = Clock::now();
+    for (int i = 0; i < rounds; ++i) {
+        sequential.watchMovie("Inception");
+    }
+    double sequentialMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / rounds;
+
+    HomeTheaterFacade parallel(amp, dvd, projector, true);
+    start = Clock::now();
+    for (int i = 0; i < rounds; ++i) {
+        parallel.watchMovieAsync("Inception").get();
+    }
+    double parallelMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / rounds;
+    setOutputSink(consoleSink());
+
+    output() << "\nStartup with 30/50/80 ms subsystems: sequential " << sequentialMs
+             << " ms, parallel " << parallelMs << " ms\n";
+    flushOutput();
+}
+
 // Client Code
 int main() {
     // Creating subsystem objects
@@ -69,14 +202,16 @@ int main() {
     DVDPlayer dvd;
     Projector projector;
 
-    // Creating the facade with subsystem objects
+    // Creating the facade over the subsystem objects (referenced, not copied)
     HomeTheaterFacade homeTheater(amp, dvd, projector);
 
     // Using the facade to watch a movie
     homeTheater.watchMovie("Inception");
 
-    // Ending the movie
-    homeTheater.endMovie();
+    // Ending the movie, asynchronously
+    std::future<void> stopped = homeTheater.endMovieAsync();
+    stopped.get();
 
+    benchmarkStartup();
     return 0;
 }
@@ -12,11 +12,30 @@
 					   that returns Product objects.
 					4. ConcreteCreator - Implements the factory method to return an
 					   instance of a ConcreteProduct.
+
+					Concrete products register themselves with the AnimalRegistry under a
+					name. The registry finds a creator through a perfect hash built from
+					the registered names, so lookup cost does not grow with the number of
+					types, and it places products in per-type slot pools.
+					createMany(type, n) builds n products contiguously in a single slab.
 */
 
 // Include necessary headers
-#include <iostream>
+#include "../../common/output_sink.h"
+#include "../../common/slab.h"
 #include <memory> 
+#include <string>
+#include <string_view>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <new>
+#include <unordered_map>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
 
 // Define the Product Interface
 class Animal {
@@ -29,43 +48,345 @@ public:
 class Dog : public Animal {
 public:
     void speak() const override {
-        std::cout << "Woof!" << std::endl;
+        output() << "Woof!\n";
     }
 };
 
 class Cat : public Animal {
 public:
     void speak() const override {
-        std::cout << "Meow!" << std::endl;
+        output() << "Meow!\n";
+    }
+};
+
+// SlotPool: Fixed-size slots for one product type, recycled through an intrusive free list
+class SlotPool {
+private:
+    static const size_t slotsPerBlock = 256;
+
+    size_t slotSize;
+    std::vector<void*> blocks;
+    void* freeList = nullptr;
+    std::atomic_flag busy = ATOMIC_FLAG_INIT; // Spin lock; the critical sections are a few loads
+
+    void lock() {
+        while (busy.test_and_set(std::memory_order_acquire)) {
+        }
+    }
+
+    void unlock() {
+        busy.clear(std::memory_order_release);
+    }
+
+public:
+    explicit SlotPool(size_t objectSize)
+        : slotSize((std::max(objectSize, sizeof(void*)) + alignof(std::max_align_t) - 1)
+                   / alignof(std::max_align_t) * alignof(std::max_align_t)) {}
+
+    ~SlotPool() {
+        for (void* block : blocks) {
+            ::operator delete(block);
+        }
+    }
+
+    SlotPool(const SlotPool&) = delete;
+    SlotPool& operator=(const SlotPool&) = delete;
+
+    void* allocate() {
+        lock();
+        if (freeList == nullptr) {
+            char* block;
+            try {
+                block = static_cast<char*>(::operator new(slotSize * slotsPerBlock));
+                blocks.push_back(block);
+            }
+            catch (...) {
+                unlock();
+                throw;
+            }
+            for (size_t i = slotsPerBlock; i-- > 0;) {
+                *reinterpret_cast<void**>(block + i * slotSize) = freeList;
+                freeList = block + i * slotSize;
+            }
+        }
+        void* slot = freeList;
+        freeList = *static_cast<void**>(slot);
+        unlock();
+        return slot;
+    }
+
+    void release(void* slot) {
+        lock();
+        *static_cast<void**>(slot) = freeList;
+        freeList = slot;
+        unlock();
+    }
+};
+
+// Destroys a pooled product and returns the slot it was constructed in
+struct PooledDeleter {
+    SlotPool* pool = nullptr;
+    void* slot = nullptr; // May differ from the Animal* under multiple or virtual inheritance
+    void operator()(Animal* animal) const {
+        animal->~Animal();
+        pool->release(slot);
+    }
+};
+
+using AnimalPtr = std::unique_ptr<Animal, PooledDeleter>;
+
+// AnimalRegistry: Maps type names to creators through a perfect hash built from the registered
+// names (hash and displace). Registration happens at startup, from one thread. The table is built
+// exactly once, on the first lookup; after that the registry is frozen and add() throws, so any
+// number of threads can create products concurrently.
+class AnimalRegistry {
+private:
+    struct Registration {
+        std::string name;
+        Animal* (*construct)(void* storage);
+        Slab<Animal> (*constructMany)(size_t count);
+        std::unique_ptr<SlotPool> pool;
+    };
+
+    std::vector<Registration> registrations;
+    std::vector<uint32_t> displacements; // Per bucket: seed of the second-level hash
+    std::vector<int32_t> slots;          // Per table slot: registration index, or -1
+    size_t slotMask = 0;
+    size_t bucketMask = 0;
+    std::once_flag built;
+    std::atomic<bool> frozen{ false };
+
+    static uint64_t hash(std::string_view key) {
+        uint64_t h = 14695981039346656037ull;
+        for (char c : key) {
+            h = (h ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+        }
+        return h;
+    }
+
+    // Second-level hash: remix the key hash with a seed instead of rehashing the key
+    static uint64_t mix(uint64_t h, uint64_t seed) {
+        h ^= seed * 0x9E3779B97F4A7C15ull;
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        return h;
+    }
+
+    // Hash and displace: buckets are placed largest first, each trying seeds until all of its
+    // names land on free slots
+    void rebuild() {
+        size_t count = registrations.size();
+        size_t tableSize = 1;
+        while (tableSize < count + count / 4 + 1) {
+            tableSize *= 2;
+        }
+        slotMask = tableSize - 1;
+        size_t bucketCount = 1;
+        while (bucketCount * 4 < count) {
+            bucketCount *= 2;
+        }
+        bucketMask = bucketCount - 1;
+        displacements.assign(bucketCount, 0);
+        slots.assign(tableSize, -1);
+
+        std::vector<std::vector<int32_t>> buckets(bucketCount);
+        for (size_t i = 0; i < count; ++i) {
+            buckets[mix(hash(registrations[i].name), 0) & bucketMask].push_back(static_cast<int32_t>(i));
+        }
+        std::vector<size_t> order(bucketCount);
+        for (size_t b = 0; b < bucketCount; ++b) {
+            order[b] = b;
+        }
+        std::sort(order.begin(), order.end(), [&](size_t x, size_t y) { return buckets[x].size() > buckets[y].size(); });
+
+        std::vector<size_t> placed;
+        for (size_t b : order) {
+            for (uint32_t seed = 1; !buckets[b].empty(); ++seed) {
+                placed.clear();
+                for (int32_t index : buckets[b]) {
+                    size_t slot = mix(hash(registrations[index].name), seed) & slotMask;
+                    if (slots[slot] != -1 || std::find(placed.begin(), placed.end(), slot) != placed.end()) {
+                        break;
+                    }
+                    placed.push_back(slot);
+                }
+                if (placed.size() == buckets[b].size()) {
+                    for (size_t k = 0; k < placed.size(); ++k) {
+                        slots[placed[k]] = buckets[b][k];
+                    }
+                    displacements[b] = seed;
+                    break;
+                }
+            }
+        }
+        frozen.store(true, std::memory_order_release);
     }
+
+    const Registration* find(std::string_view name) {
+        std::call_once(built, [this] { rebuild(); });
+        if (registrations.empty()) {
+            return nullptr;
+        }
+        uint64_t h = hash(name);
+        uint32_t seed = displacements[mix(h, 0) & bucketMask];
+        int32_t index = slots[mix(h, seed) & slotMask];
+        if (index < 0 || registrations[index].name != name) {
+            return nullptr; // Unknown names can land on any slot
+        }
+        return &registrations[index];
+    }
+
+public:
+    static AnimalRegistry& instance() {
+        static AnimalRegistry registry;
+        return registry;
+    }
+
+    // Register Product under name; returns false if the name is taken. Throws std::logic_error
+    // once the registry has been used for lookups.
+    template <typename Product>
+    bool add(std::string_view name) {
+        if (frozen.load(std::memory_order_acquire)) {
+            throw std::logic_error("Cannot register " + std::string(name) + " after the registry is in use");
+        }
+        for (const Registration& registration : registrations) {
+            if (registration.name == name) {
+                return false;
+            }
+        }
+        registrations.push_back(Registration{ std::string(name),
+                                              [](void* storage) -> Animal* { return new (storage) Product(); },
+                                              [](size_t count) { return Slab<Animal>::make<Product>(count); },
+                                              std::unique_ptr<SlotPool>(new SlotPool(sizeof(Product))) });
+        return true;
+    }
+
+    // Create the product registered under name, or nullptr if the name is unknown
+    AnimalPtr create(std::string_view name) {
+        const Registration* registration = find(name);
+        if (registration == nullptr) {
+            return AnimalPtr();
+        }
+        void* storage = registration->pool->allocate();
+        try {
+            return AnimalPtr(registration->construct(storage), PooledDeleter{ registration->pool.get(), storage });
+        }
+        catch (...) {
+            registration->pool->release(storage);
+            throw;
+        }
+    }
+
+    // Create count products registered under name in one slab; empty if the name is unknown
+    Slab<Animal> createMany(std::string_view name, size_t count) {
+        const Registration* registration = find(name);
+        return registration != nullptr ? registration->constructMany(count) : Slab<Animal>();
+    }
+
+    size_t size() const { return registrations.size(); }
 };
 
+// Self-registration: a static AnimalRegistration<T> adds T to the global registry at startup
+template <typename Product>
+struct AnimalRegistration {
+    explicit AnimalRegistration(std::string_view name) {
+        AnimalRegistry::instance().add<Product>(name);
+    }
+};
+
+static AnimalRegistration<Dog> dogRegistration("dog");
+static AnimalRegistration<Cat> catRegistration("cat");
+
 // Define the Factory Class
 class AnimalFactory {
 public:
-    // Factory Method
-    static std::unique_ptr<Animal> createAnimal(const std::string& type) {
-        if (type == "dog") {
-            return std::make_unique<Dog>();
+    // Factory Method: looks the type up in the registry, so new types need no change here
+    static AnimalPtr createAnimal(std::string_view type) {
+        return AnimalRegistry::instance().create(type); // nullptr if type is unknown
+    }
+
+    // Bulk Factory Method: count products of one type, stored contiguously
+    static Slab<Animal> createMany(std::string_view type, size_t count) {
+        return AnimalRegistry::instance().createMany(type, count); // Empty if type is unknown
+    }
+};
+
+// Benchmark product: speaks without output
+class Quiet : public Animal {
+public:
+    void speak() const override {}
+};
+
+// Benchmark: creation latency by number of registered types, for a string if/else chain,
+// a hash map and the perfect-hash registry
+void benchmarkRegistry() {
+    using Clock = std::chrono::steady_clock;
+    const size_t creations = 2000000;
+
+    for (size_t typeCount : { 3, 100, 1000 }) {
+        std::vector<std::string> names;
+        for (size_t i = 0; i < typeCount; ++i) {
+            names.push_back("animal_type_" + std::to_string(i));
+        }
+        // Keys spread over all types so each lookup depth is exercised
+        std::vector<std::string_view> keys;
+        for (size_t i = 0; i < 4096; ++i) {
+            keys.push_back(names[(i * 2654435761u) % typeCount]);
         }
-        else if (type == "cat") {
-            return std::make_unique<Cat>();
+
+        auto measure = [&](auto create) {
+            auto start = Clock::now();
+            for (size_t i = 0; i < creations; ++i) {
+                auto animal = create(keys[i & 4095]);
+                animal->speak();
+            }
+            return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / creations;
+        };
+
+        // if/else chain: compare against every name in registration order
+        double chain = measure([&](std::string_view key) {
+            for (const std::string& name : names) {
+                if (key == name) {
+                    return std::unique_ptr<Animal>(new Quiet());
+                }
+            }
+            return std::unique_ptr<Animal>();
+        });
+
+        std::unordered_map<std::string, std::unique_ptr<Animal> (*)()> map;
+        for (const std::string& name : names) {
+            map.emplace(name, []() { return std::unique_ptr<Animal>(new Quiet()); });
         }
-        else {
-            return nullptr; // Return nullptr if type is unknown
+        double hashed = measure([&](std::string_view key) { return map.find(std::string(key))->second(); });
+
+        AnimalRegistry registry;
+        for (const std::string& name : names) {
+            registry.add<Quiet>(name);
         }
+        double perfect = measure([&](std::string_view key) { return registry.create(key); });
+
+        output() << typeCount << " types: if/else " << chain << " ns, unordered_map " << hashed
+                 << " ns, perfect hash + pool " << perfect << " ns\n";
     }
-};
+    flushOutput();
+}
 
 // Main function to demonstrate usage
 int main() {
     // Create a Dog using the Factory Method
-    std::unique_ptr<Animal> dog = AnimalFactory::createAnimal("dog");
+    AnimalPtr dog = AnimalFactory::createAnimal("dog");
     if (dog) dog->speak(); // Output: Woof!
 
     // Create a Cat using the Factory Method
-    std::unique_ptr<Animal> cat = AnimalFactory::createAnimal("cat");
+    AnimalPtr cat = AnimalFactory::createAnimal("cat");
     if (cat) cat->speak(); // Output: Meow!
 
+    // Create several Cats at once
+    for (const Animal& animal : AnimalFactory::createMany("cat", 2)) {
+        animal.speak(); // Output: Meow! (twice)
+    }
+
+    benchmarkRegistry();
     return 0;
 }
\ No newline at end of file
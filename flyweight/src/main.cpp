@@ -15,7 +15,7 @@
 */
 
 // Include necessary headers
-#include <iostream>
+#include "../../common/output_sink.h"
 #include <unordered_map>
 #include <memory>
 
@@ -33,7 +33,7 @@ private:
 public:
     ConcreteFlyweight(std::string state) : intrinsicState(state) {}
     void operation(const std::string& extrinsicState) const override {
-        std::cout << "Flyweight with intrinsic state [" << intrinsicState
+        output() << "Flyweight with intrinsic state [" << intrinsicState
             << "] and extrinsic state [" << extrinsicState << "]\n";
     }
 };
@@ -12,7 +12,7 @@
 */
 
 // Include necessary headers
-#include <iostream>
+#include "../../common/output_sink.h"
 #include <string>
 #include <map>
 
@@ -73,8 +73,8 @@ int main() {
 	Expression* expression1 = new AddExpression(new VariableExpression("x"), new ConstantExpression(6));
 
     // Interpret and print results
-    std::cout << "Result of expression 'x + y': " << expression->interpret(context) << std::endl; // Output: 15
-    std::cout << "Result of expression 'x + 6': " << expression1->interpret(context) << std::endl; // Output: 16
+    output() << "Result of expression 'x + y': " << expression->interpret(context) << '\n'; // Output: 15
+    output() << "Result of expression 'x + 6': " << expression1->interpret(context) << '\n'; // Output: 16
 
     // Clean up
     delete expression;
@@ -9,35 +9,105 @@
                                  current position.
               Aggregate (Collection Interface): Defines an interface for creating an iterator.
               Concrete Aggregate: Implements the Aggregate interface and stores the elements.
+
+              Iterators are views over the aggregate's storage and never copy it. The aggregate
+              is a C++20 contiguous range, so range-for and std::ranges algorithms work on it
+              directly. Callers of the virtual interface can use nextBlock to fetch many elements
+              per call and amortize the dispatch cost.
+
+              MappedAggregate streams integers from a memory-mapped file, for datasets larger
+              than RAM. Its iterator runs a read-ahead thread that faults pages in ahead of the
+              consumer and releases pages that have already been consumed.
+
+              Iterators can be splittable: trySplit hands the first half of the remaining
+              elements to a new iterator. parallelForEach and parallelReduce split iterators
+              on a work-stealing scheduler to consume any Aggregate on all cores.
+
+              lazy(aggregate) starts a pipeline of map, filter, take and zip adapters. Adapters
+              are composed as templates, so the whole pipeline inlines into one streaming loop
+              without intermediate vectors; the only virtual call is nextBlock, once per block.
  */
 
 // Include necessary headers
-#include <iostream>
+#include "../../common/output_sink.h"
 #include <vector>
+#include <span>
+#include <ranges>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <memory>
+#include <chrono>
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <string>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <array>
+#include <utility>
+#include <type_traits>
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 // Define an Iterator Interface
 class Iterator {
 public:
     virtual bool hasNext() = 0; // Check if there is a next element
-    virtual int next() = 0;     // Return the next element
+    virtual int next() = 0;     // Return the next element; requires hasNext()
+    virtual size_t nextBlock(std::span<int> buffer) = 0; // Fill buffer, return count; 0 at the end
+    virtual Iterator* trySplit() { return nullptr; }     // Take over the first half, or nullptr
+    virtual size_t estimateSize() { return 0; }          // Remaining elements; 0 if unknown
     virtual ~Iterator() {}
 };
 
-// Create a Concrete Iterator
-class ConcreteIterator : public Iterator {
+// Create a Concrete Iterator: a non-owning view over the aggregate's elements
+class ConcreteIterator final : public Iterator {
 private:
-    std::vector<int> collection;
+    std::span<const int> collection;
     size_t index;
 public:
-    ConcreteIterator(const std::vector<int>& coll) : collection(coll), index(0) {}
+    explicit ConcreteIterator(std::span<const int> coll) : collection(coll), index(0) {}
 
     bool hasNext() override {
         return index < collection.size();
     }
 
     int next() override {
-        return hasNext() ? collection[index++] : -1; // Return element and move to the next
+        if (!hasNext()) {
+            throw std::out_of_range("Iterator exhausted");
+        }
+        return collection[index++]; // Return element and move to the next
     }
+
+    size_t nextBlock(std::span<int> buffer) override {
+        size_t count = std::min(buffer.size(), collection.size() - index);
+        std::copy_n(collection.begin() + index, count, buffer.begin());
+        index += count;
+        return count;
+    }
+
+    Iterator* trySplit() override {
+        size_t remaining = collection.size() - index;
+        if (remaining < 2) {
+            return nullptr;
+        }
+        Iterator* prefix = new ConcreteIterator(collection.subspan(index, remaining / 2));
+        collection = collection.subspan(index + remaining / 2);
+        index = 0;
+        return prefix;
+    }
+
+    size_t estimateSize() override { return collection.size() - index; }
 };
 
 // Define an Aggregate Interface
@@ -53,14 +123,755 @@ private:
     std::vector<int> collection;
 public:
     ConcreteAggregate(std::initializer_list<int> values) : collection(values) {}
+    explicit ConcreteAggregate(std::vector<int> values) : collection(std::move(values)) {}
+
+    Iterator* createIterator() override {
+        return new ConcreteIterator(view());
+    }
+
+    // Stack-allocated iterator; no heap allocation and calls can be devirtualized
+    ConcreteIterator iterator() const { return ConcreteIterator(view()); }
+
+    // Range access: the aggregate itself is a contiguous range, and view() is a borrowed view
+    std::span<const int> view() const { return collection; }
+    const int* begin() const { return collection.data(); }
+    const int* end() const { return collection.data() + collection.size(); }
+    size_t size() const { return collection.size(); }
+};
+
+static_assert(std::ranges::contiguous_range<const ConcreteAggregate>);
+static_assert(std::ranges::sized_range<const ConcreteAggregate>);
+static_assert(std::ranges::view<std::span<const int>>);
+
+// Benchmark: summing 100M ints through each iteration interface
+void benchmarkIteration() {
+    using Clock = std::chrono::steady_clock;
+    const size_t elementCount = 100000000;
+
+    std::vector<int> values(elementCount);
+    std::iota(values.begin(), values.end(), 0);
+    for (int& value : values) {
+        value &= 0xff;
+    }
+    ConcreteAggregate aggregate(std::move(values));
+
+    auto report = [&](const char* label, Clock::time_point start, int64_t sum) {
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        output() << label << elementCount / seconds / 1e6 << " M ints/s (sum " << sum << ")\n";
+    };
+
+    auto start = Clock::now();
+    int64_t sum = 0;
+    std::unique_ptr<Iterator> iterator(aggregate.createIterator());
+    while (iterator->hasNext()) {
+        sum += iterator->next();
+    }
+    report("virtual hasNext/next:    ", start, sum);
+
+    start = Clock::now();
+    sum = 0;
+    iterator.reset(aggregate.createIterator());
+    int buffer[1024];
+    while (size_t count = iterator->nextBlock(buffer)) {
+        for (size_t i = 0; i < count; ++i) {
+            sum += buffer[i];
+        }
+    }
+    report("virtual nextBlock(1024): ", start, sum);
+
+    start = Clock::now();
+    sum = 0;
+    ConcreteIterator local = aggregate.iterator();
+    while (local.hasNext()) {
+        sum += local.next();
+    }
+    report("stack iterator:          ", start, sum);
+
+    start = Clock::now();
+    sum = 0;
+    for (int value : aggregate) {
+        sum += value;
+    }
+    report("range-for:               ", start, sum);
+
+    start = Clock::now();
+    sum = 0;
+    std::ranges::for_each(aggregate.view(), [&](int value) { sum += value; });
+    report("std::ranges::for_each:   ", start, sum);
+    flushOutput();
+}
+
+#ifdef __linux__
+// Iterator over a mapped file; a read-ahead thread keeps a window of pages resident in front of
+// the consumer and drops pages behind it so resident memory stays bounded. Between refills it
+// sleeps on a condition variable until the consumer is half way through the window. The thread starts on
+// first consumption, so an iterator can still be split beforehand; split pieces are meant for
+// parallel consumers and rely on kernel read-ahead instead.
+class MappedIterator final : public Iterator {
+private:
+    static const size_t aheadBytes = 64 << 20;   // Fault in this far ahead of the consumer
+    static const size_t publishInts = 64 << 10;  // next() publishes its position this often
+
+    const int* data;
+    size_t index;
+    size_t last;
+    size_t pageSize;
+    bool readAheadEnabled;
+    std::atomic<size_t> consumed;      // Consumer position, published every block
+    std::atomic<size_t> wakeAt;        // Position at which the sleeping read-ahead thread wants a wake-up
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping;
+    std::thread readAhead;
+
+    size_t pageDown(size_t byte) const { return byte / pageSize * pageSize; }
+
+    void startReadAhead() {
+        if (readAheadEnabled && !readAhead.joinable()) {
+            consumed.store(index);
+            readAhead = std::thread(&MappedIterator::readAheadLoop, this, index, last);
+        }
+    }
+
+    void readAheadLoop(size_t first, size_t end) {
+        const char* base = reinterpret_cast<const char*>(data);
+        const size_t endByte = end * sizeof(int);
+        size_t prefetched = first * sizeof(int);
+        size_t released = pageDown(prefetched);
+        for (;;) {
+            size_t position = consumed.load() * sizeof(int);
+            size_t target = std::min(endByte, position + aheadBytes);
+            if (prefetched < target) {
+                madvise(const_cast<char*>(base) + pageDown(prefetched), target - pageDown(prefetched), MADV_WILLNEED);
+                volatile char sink = 0;
+                for (size_t byte = pageDown(prefetched); byte < target; byte += pageSize) {
+                    sink = sink + base[byte]; // Touch each page so the fault happens here
+                }
+                prefetched = target;
+            }
+            size_t releasable = pageDown(position);
+            if (releasable > released) {
+                madvise(const_cast<char*>(base) + released, releasable - released, MADV_DONTNEED);
+                released = releasable;
+            }
+            // Sleep until half of the window ahead has been consumed
+            size_t wakePosition = (position + aheadBytes / 2) / sizeof(int);
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeAt.store(wakePosition);
+            wake.wait(lock, [&] { return stopping || consumed.load() >= wakePosition; });
+            wakeAt.store(SIZE_MAX);
+            if (stopping) {
+                return;
+            }
+        }
+    }
+
+    // Publish the consumer position and wake the read-ahead thread if it is waiting for it. The
+    // seq_cst store/load pair here and in readAheadLoop ensures one side always sees the other.
+    void publish() {
+        consumed.store(index);
+        if (index >= wakeAt.load()) {
+            std::lock_guard<std::mutex> lock(mutex);
+            wake.notify_one();
+        }
+    }
+
+public:
+    MappedIterator(const int* mapped, size_t first, size_t end, bool withReadAhead)
+        : data(mapped), index(first), last(end), pageSize(static_cast<size_t>(sysconf(_SC_PAGESIZE))),
+          readAheadEnabled(withReadAhead), consumed(first), wakeAt(SIZE_MAX), stopping(false) {}
+
+    ~MappedIterator() {
+        if (readAhead.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            wake.notify_one();
+            readAhead.join();
+        }
+    }
+
+    bool hasNext() override {
+        return index < last;
+    }
+
+    int next() override {
+        if (!hasNext()) {
+            throw std::out_of_range("Iterator exhausted");
+        }
+        if (index % publishInts == 0) {
+            startReadAhead();
+            publish();
+        }
+        return data[index++];
+    }
+
+    size_t nextBlock(std::span<int> buffer) override {
+        startReadAhead();
+        size_t blockSize = std::min(buffer.size(), last - index);
+        std::copy_n(data + index, blockSize, buffer.begin());
+        index += blockSize;
+        publish();
+        return blockSize;
+    }
+
+    Iterator* trySplit() override {
+        if (readAhead.joinable() || last - index < 2) {
+            return nullptr; // Already streaming, or nothing to split
+        }
+        size_t middle = index + (last - index) / 2;
+        Iterator* prefix = new MappedIterator(data, index, middle, false);
+        index = middle;
+        readAheadEnabled = false;
+        return prefix;
+    }
+
+    size_t estimateSize() override { return last - index; }
+};
+
+// Aggregate backed by a read-only memory-mapped file of native-endian ints
+class MappedAggregate : public Aggregate {
+private:
+    int fd;
+    void* mapping;
+    size_t count;
+public:
+    explicit MappedAggregate(const std::string& path) : fd(-1), mapping(nullptr), count(0) {
+        fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open " + path);
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            close(fd);
+            throw std::runtime_error("Cannot stat " + path);
+        }
+        count = static_cast<size_t>(info.st_size) / sizeof(int);
+        if (count != 0) {
+            mapping = mmap(nullptr, count * sizeof(int), PROT_READ, MAP_SHARED, fd, 0);
+            if (mapping == MAP_FAILED) {
+                close(fd);
+                throw std::runtime_error("Cannot map " + path);
+            }
+            madvise(mapping, count * sizeof(int), MADV_SEQUENTIAL);
+        }
+    }
+
+    ~MappedAggregate() {
+        if (mapping != nullptr) {
+            munmap(mapping, count * sizeof(int));
+        }
+        close(fd);
+    }
+
+    MappedAggregate(const MappedAggregate&) = delete;
+    MappedAggregate& operator=(const MappedAggregate&) = delete;
 
     Iterator* createIterator() override {
-        return new ConcreteIterator(collection);
+        return new MappedIterator(static_cast<const int*>(mapping), 0, count, true);
     }
+
+    size_t size() const { return count; }
 };
 
+// Evict a file from the page cache so each scan starts cold
+void dropFromPageCache(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+}
+
+// Write elementCount ints (i & 0xff) to path and sync them to disk
+bool writeScanFile(const std::string& path, size_t elementCount) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    std::vector<int> block(1 << 20);
+    for (size_t written = 0; written < elementCount; written += block.size()) {
+        size_t blockSize = std::min(block.size(), elementCount - written);
+        for (size_t i = 0; i < blockSize; ++i) {
+            block[i] = static_cast<int>((written + i) & 0xff);
+        }
+        std::fwrite(block.data(), sizeof(int), blockSize, file);
+    }
+    std::fclose(file);
+    int fd = open(path.c_str(), O_RDONLY);
+    fsync(fd); // Dirty pages cannot be dropped from the cache
+    close(fd);
+    return true;
+}
+
+// Benchmark: sequential scan of an int file, mapped and streamed versus read in chunks with fread
+void benchmarkMappedScan(size_t megabytes) {
+    using Clock = std::chrono::steady_clock;
+    const std::string path = "/tmp/iterator_scan_" + std::to_string(getpid()) + ".bin";
+    const size_t elementCount = megabytes * (1 << 20) / sizeof(int);
+
+    if (!writeScanFile(path, elementCount)) {
+        output() << "Cannot create " << path << '\n';
+        return;
+    }
+
+    auto report = [&](const char* label, Clock::time_point start, int64_t sum) {
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        output() << label << megabytes / seconds << " MB/s (sum " << sum << ")\n";
+    };
+    int buffer[4096];
+
+    dropFromPageCache(path);
+    auto start = Clock::now();
+    int64_t sum = 0;
+    {
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        if (file == nullptr) {
+            output() << "Cannot open " << path << '\n';
+            std::remove(path.c_str());
+            return;
+        }
+        std::vector<int> chunk(1 << 20); // Streams in 4 MB chunks, so files larger than RAM work
+        while (size_t read = std::fread(chunk.data(), sizeof(int), chunk.size(), file)) {
+            for (size_t i = 0; i < read; ++i) {
+                sum += chunk[i];
+            }
+        }
+        std::fclose(file);
+    }
+    report("fread in chunks:             ", start, sum);
+
+    MappedAggregate aggregate(path);
+
+    dropFromPageCache(path);
+    start = Clock::now();
+    sum = 0;
+    {
+        std::unique_ptr<Iterator> iterator(aggregate.createIterator());
+        while (size_t blockSize = iterator->nextBlock(buffer)) {
+            for (size_t i = 0; i < blockSize; ++i) {
+                sum += buffer[i];
+            }
+        }
+    }
+    report("mapped, nextBlock:           ", start, sum);
+
+    dropFromPageCache(path);
+    start = Clock::now();
+    sum = 0;
+    {
+        std::unique_ptr<Iterator> iterator(aggregate.createIterator());
+        while (iterator->hasNext()) {
+            sum += iterator->next();
+        }
+    }
+    report("mapped, hasNext/next:        ", start, sum);
+
+    std::remove(path.c_str());
+    flushOutput();
+}
+#else
+void benchmarkMappedScan(size_t) {
+    output() << "Memory-mapped aggregate requires Linux (mmap and madvise)\n";
+}
+#endif
+
+// Work-stealing consumption of splittable iterators. Each worker owns a deque of iterators: it
+// splits the one it holds down to grainSize, keeping the first half and pushing the second on its
+// own deque, then consumes its piece in blocks. Idle workers steal the oldest (largest) iterators from others.
+template <typename Consume>
+void consumeInParallel(Aggregate& aggregate, Consume consume, unsigned threadCount, size_t grainSize) {
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<std::unique_ptr<Iterator>> iterators;
+    };
+    threadCount = std::max(1u, threadCount);
+    std::vector<WorkQueue> queues(threadCount);
+    std::atomic<size_t> pending(1);
+    queues[0].iterators.emplace_back(aggregate.createIterator());
+
+    auto take = [&](unsigned self, std::unique_ptr<Iterator>& iterator) {
+        for (unsigned k = 0; k < threadCount; ++k) {
+            WorkQueue& queue = queues[(self + k) % threadCount];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.iterators.empty()) {
+                if (k == 0) {
+                    iterator = std::move(queue.iterators.back()); // Own work: the adjacent piece
+                    queue.iterators.pop_back();
+                }
+                else {
+                    iterator = std::move(queue.iterators.front()); // Steal the largest
+                    queue.iterators.pop_front();
+                }
+                return true;
+            }
+        }
+        return false;
+    };
+
+    auto worker = [&](unsigned self) {
+        std::unique_ptr<Iterator> iterator;
+        int buffer[4096];
+        while (pending.load(std::memory_order_acquire) > 0) {
+            if (!take(self, iterator)) {
+                std::this_thread::yield();
+                continue;
+            }
+            while (iterator->estimateSize() > grainSize) {
+                std::unique_ptr<Iterator> prefix(iterator->trySplit());
+                if (!prefix) {
+                    break;
+                }
+                pending.fetch_add(1, std::memory_order_relaxed);
+                std::lock_guard<std::mutex> lock(queues[self].mutex);
+                queues[self].iterators.push_back(std::move(iterator)); // Keep the prefix so each
+                iterator = std::move(prefix);                            // worker reads forward
+            }
+            while (size_t count = iterator->nextBlock(buffer)) {
+                consume(self, std::span<const int>(buffer, count));
+            }
+            iterator.reset();
+            pending.fetch_sub(1, std::memory_order_release);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threadCount; ++t) {
+        workers.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& thread : workers) {
+        thread.join();
+    }
+}
+
+// Apply body to every element of aggregate on threadCount workers; no ordering between elements
+template <typename Body>
+void parallelForEach(Aggregate& aggregate, Body body, unsigned threadCount, size_t grainSize = 1 << 16) {
+    consumeInParallel(aggregate, [&](unsigned, std::span<const int> block) {
+        for (int value : block) {
+            body(value);
+        }
+    }, threadCount, grainSize);
+}
+
+// Fold every element into per-worker accumulators with accumulate(T&, int), then merge them with
+// combine(T&, const T&). combine must be associative and commutative; the split order varies.
+template <typename T, typename Accumulate, typename Combine>
+T parallelReduce(Aggregate& aggregate, T identity, Accumulate accumulate, Combine combine,
+                 unsigned threadCount, size_t grainSize = 1 << 16) {
+    struct alignas(64) Slot {
+        T value;
+    };
+    threadCount = std::max(1u, threadCount);
+    std::vector<Slot> slots(threadCount, Slot{ identity });
+    consumeInParallel(aggregate, [&](unsigned worker, std::span<const int> block) {
+        T& value = slots[worker].value;
+        for (int element : block) {
+            accumulate(value, element);
+        }
+    }, threadCount, grainSize);
+    T result = identity;
+    for (const Slot& slot : slots) {
+        combine(result, slot.value);
+    }
+    return result;
+}
+
+// Benchmark: scaling of parallelReduce and parallelForEach across cores, on a 256 MB in-memory
+// aggregate and, if fileMegabytes is not 0, on a memory-mapped file of that size
+void benchmarkParallelScan(size_t fileMegabytes) {
+    using Clock = std::chrono::steady_clock;
+    size_t megabytes = 256;
+    auto accumulate = [](int64_t& sum, int value) { sum += value; };
+    auto combine = [](int64_t& into, const int64_t& from) { into += from; };
+
+    unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    // prepare() returns the aggregate to scan, starting each pass from the same cache state
+    auto scale = [&](const char* label, const std::function<Aggregate&()>& prepare) {
+        for (unsigned threads = 1; ; threads = std::min(threads * 2, maxThreads)) {
+            Aggregate& reduceAggregate = prepare();
+            auto start = Clock::now();
+            int64_t sum = parallelReduce<int64_t>(reduceAggregate, 0, accumulate, combine, threads);
+            double reduceSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+            Aggregate& forEachAggregate = prepare();
+            std::atomic<int64_t> count(0);
+            start = Clock::now();
+            parallelForEach(forEachAggregate, [&](int value) {
+                if (value == 0) {
+                    count.fetch_add(1, std::memory_order_relaxed);
+                }
+            }, threads);
+            double forEachSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+            output() << label << threads << " threads: reduce " << megabytes / reduceSeconds << " MB/s (sum "
+                     << sum << "), for-each " << megabytes / forEachSeconds << " MB/s (" << count.load()
+                     << " zeros)\n";
+            if (threads == maxThreads) {
+                break;
+            }
+        }
+    };
+
+    {
+        const size_t elementCount = megabytes * (1 << 20) / sizeof(int);
+        std::vector<int> values(elementCount);
+        for (size_t i = 0; i < elementCount; ++i) {
+            values[i] = static_cast<int>(i & 0xff);
+        }
+        ConcreteAggregate aggregate(std::move(values));
+        scale("in memory, ", [&]() -> Aggregate& { return aggregate; });
+    }
+
+#ifdef __linux__
+    if (fileMegabytes == 0) {
+        flushOutput();
+        return;
+    }
+    megabytes = fileMegabytes;
+    const std::string path = "/tmp/iterator_parallel_" + std::to_string(getpid()) + ".bin";
+    if (!writeScanFile(path, megabytes * (1 << 20) / sizeof(int))) {
+        output() << "Cannot create " << path << '\n';
+        return;
+    }
+    {
+        std::unique_ptr<MappedAggregate> aggregate;
+        scale("mapped,    ", [&]() -> Aggregate& {
+            aggregate.reset(); // Mapped pages cannot be evicted while still mapped
+            dropFromPageCache(path);
+            aggregate.reset(new MappedAggregate(path));
+            return *aggregate;
+        });
+    }
+    std::remove(path.c_str());
+#endif
+    flushOutput();
+}
+
+// Lazy pipeline source: pulls elements from an Iterator one block at a time
+class BlockSource {
+private:
+    std::unique_ptr<Iterator> iterator;
+    std::array<int, 1024> buffer{};
+    size_t position = 0;
+    size_t count = 0;
+public:
+    using value_type = int;
+
+    explicit BlockSource(Iterator* source) : iterator(source) {}
+
+    bool next(int& out) {
+        if (position == count) {
+            count = iterator->nextBlock(buffer);
+            position = 0;
+            if (count == 0) {
+                return false;
+            }
+        }
+        out = buffer[position++];
+        return true;
+    }
+};
+
+// Lazy adapters: each pulls from its source on demand and holds no buffer of its own
+template <typename Source, typename Function>
+class MapAdapter {
+private:
+    Source source;
+    Function function;
+public:
+    using value_type = std::decay_t<std::invoke_result_t<Function&, typename Source::value_type>>;
+
+    MapAdapter(Source from, Function f) : source(std::move(from)), function(std::move(f)) {}
+
+    bool next(value_type& out) {
+        typename Source::value_type value;
+        if (!source.next(value)) {
+            return false;
+        }
+        out = function(value);
+        return true;
+    }
+};
+
+template <typename Source, typename Predicate>
+class FilterAdapter {
+private:
+    Source source;
+    Predicate predicate;
+public:
+    using value_type = typename Source::value_type;
+
+    FilterAdapter(Source from, Predicate p) : source(std::move(from)), predicate(std::move(p)) {}
+
+    bool next(value_type& out) {
+        while (source.next(out)) {
+            if (predicate(out)) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+template <typename Source>
+class TakeAdapter {
+private:
+    Source source;
+    size_t remaining;
+public:
+    using value_type = typename Source::value_type;
+
+    TakeAdapter(Source from, size_t count) : source(std::move(from)), remaining(count) {}
+
+    bool next(value_type& out) {
+        if (remaining == 0 || !source.next(out)) {
+            return false;
+        }
+        --remaining;
+        return true;
+    }
+};
+
+template <typename First, typename Second>
+class ZipAdapter {
+private:
+    First first;
+    Second second;
+public:
+    using value_type = std::pair<typename First::value_type, typename Second::value_type>;
+
+    ZipAdapter(First a, Second b) : first(std::move(a)), second(std::move(b)) {}
+
+    bool next(value_type& out) {
+        return first.next(out.first) && second.next(out.second); // Ends with the shorter source
+    }
+};
+
+// Fluent front end for a lazy pipeline; each call consumes this stage and returns the next one
+template <typename Source>
+class Lazy {
+private:
+    Source source;
+public:
+    using value_type = typename Source::value_type;
+
+    explicit Lazy(Source from) : source(std::move(from)) {}
+
+    template <typename Function>
+    Lazy<MapAdapter<Source, Function>> map(Function function) && {
+        return Lazy<MapAdapter<Source, Function>>(MapAdapter<Source, Function>(std::move(source), std::move(function)));
+    }
+
+    template <typename Predicate>
+    Lazy<FilterAdapter<Source, Predicate>> filter(Predicate predicate) && {
+        return Lazy<FilterAdapter<Source, Predicate>>(FilterAdapter<Source, Predicate>(std::move(source), std::move(predicate)));
+    }
+
+    Lazy<TakeAdapter<Source>> take(size_t count) && {
+        return Lazy<TakeAdapter<Source>>(TakeAdapter<Source>(std::move(source), count));
+    }
+
+    template <typename Other>
+    Lazy<ZipAdapter<Source, Other>> zip(Lazy<Other> other) && {
+        return Lazy<ZipAdapter<Source, Other>>(ZipAdapter<Source, Other>(std::move(source), std::move(other).release()));
+    }
+
+    Source release() && { return std::move(source); }
+
+    bool next(value_type& out) { return source.next(out); }
+
+    // Terminal operations: run the fused loop
+    template <typename Body>
+    void forEach(Body body) && {
+        value_type value;
+        while (source.next(value)) {
+            body(value);
+        }
+    }
+
+    template <typename T, typename Accumulate>
+    T fold(T initial, Accumulate accumulate) && {
+        value_type value;
+        while (source.next(value)) {
+            initial = accumulate(initial, value);
+        }
+        return initial;
+    }
+};
+
+// Start a lazy pipeline over any Aggregate
+inline Lazy<BlockSource> lazy(Aggregate& aggregate) {
+    return Lazy<BlockSource>(BlockSource(aggregate.createIterator()));
+}
+
+// Benchmark: a 5-stage pipeline fused lazily versus materializing every stage into a vector
+void benchmarkLazyPipeline() {
+    using Clock = std::chrono::steady_clock;
+    const size_t elementCount = 100000000;
+    const size_t takeCount = elementCount / 4;
+
+    std::vector<int> values(elementCount);
+    std::iota(values.begin(), values.end(), 0);
+    ConcreteAggregate aggregate(std::move(values));
+
+    auto triple = [](int x) { return static_cast<int64_t>(x) * 3; };
+    auto even = [](int64_t x) { return x % 2 == 0; };
+    auto increment = [](int64_t x) { return x + 1; };
+    auto notFives = [](int64_t x) { return x % 5 != 0; };
+    auto add = [](int64_t sum, int64_t x) { return sum + x; };
+
+    // take() stops the lazy pipeline early, so its throughput counts only the elements it pulled
+    size_t consumed = 0;
+    auto count = [&consumed](int x) { ++consumed; return x; };
+
+    auto start = Clock::now();
+    int64_t lazySum = lazy(aggregate).map(count).map(triple).filter(even).map(increment).filter(notFives).take(takeCount)
+                                     .fold(int64_t(0), add);
+    double lazySeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    start = Clock::now();
+    std::vector<int> source(aggregate.size());
+    std::unique_ptr<Iterator> iterator(aggregate.createIterator());
+    source.resize(iterator->nextBlock(source));
+    std::vector<int64_t> tripled;
+    tripled.reserve(source.size());
+    for (int x : source) {
+        tripled.push_back(triple(x));
+    }
+    std::vector<int64_t> evens;
+    evens.reserve(tripled.size());
+    for (int64_t x : tripled) {
+        if (even(x)) {
+            evens.push_back(x);
+        }
+    }
+    std::vector<int64_t> incremented;
+    incremented.reserve(evens.size());
+    for (int64_t x : evens) {
+        incremented.push_back(increment(x));
+    }
+    std::vector<int64_t> kept;
+    kept.reserve(incremented.size());
+    for (int64_t x : incremented) {
+        if (notFives(x)) {
+            kept.push_back(x);
+        }
+    }
+    kept.resize(std::min(kept.size(), takeCount));
+    int64_t eagerSum = std::accumulate(kept.begin(), kept.end(), int64_t(0));
+    double eagerSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    output() << "lazy fused pipeline:   " << consumed / lazySeconds / 1e6 << " M ints/s (sum " << lazySum << ", "
+             << consumed << " of " << elementCount << " ints consumed)\n";
+    output() << "materialized stages:   " << elementCount / eagerSeconds / 1e6 << " M ints/s (sum " << eagerSum << ")\n";
+    flushOutput();
+}
+
 // Client Code
-int main() {
+int main(int argc, char* argv[]) {
     // Create a collection (Concrete Aggregate)
     ConcreteAggregate aggregate = { 1, 2, 3, 4, 5 };
 
@@ -69,11 +880,38 @@ int main() {
 
     // Use the iterator to traverse the collection
     while (iterator->hasNext()) {
-        std::cout << iterator->next() << " ";
+        output() << iterator->next() << " ";
     }
-    std::cout << std::endl;
+    output() << '\n';
 
     // Clean up memory
     delete iterator;
+
+    // Range-compatible traversal without an iterator object
+    for (int value : aggregate) {
+        output() << value << " ";
+    }
+    output() << '\n';
+
+    // Lazy adapters: squares of the odd elements (1, 9, 25), zipped with the collection from the start
+    lazy(aggregate).filter([](int x) { return x % 2 != 0; }).map([](int x) { return x * x; })
+                   .zip(lazy(aggregate)).forEach([](const std::pair<int, int>& pair) {
+        output() << pair.first << ":" << pair.second << " ";
+    });
+    output() << '\n';
+
+    benchmarkIteration();
+
+    // The memory-mapped benchmarks write a temporary file of the size given in MB, so they only run
+    // on request; a size larger than RAM exercises streaming
+    size_t megabytes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 0;
+    if (megabytes != 0) {
+        benchmarkMappedScan(megabytes);
+    }
+    else {
+        output() << "Pass a file size in MB to run the memory-mapped benchmarks\n";
+    }
+    benchmarkParallelScan(megabytes);
+    benchmarkLazyPipeline();
     return 0;
 }
@@ -9,11 +9,47 @@
                                 between components.
               Component: Represents an object that interacts with other components via the Mediator.
               ConcreteComponent: A specific implementation of a component.
+
+              EventBus is a mediator for many components: components subscribe to integer
+              topics, routing uses a precomputed topic-to-subscriber table, and payloads are
+              shared by reference count instead of being copied per receiver.
+
+              AsyncEventBus is its actor-style mode: every component has a bounded MPSC
+              mailbox, and a scheduler drains mailboxes on a thread pool. Each component
+              handles its messages one at a time, in arrival order.
+
+              SharedMemoryMediator connects components living in two processes on the same
+              host through rings of fixed-size slots in POSIX shared memory, with futex
+              wakeups (Linux only).
  */
 
 // Include necessary headers
-#include <iostream>
+#include "../../common/output_sink.h"
 #include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <unordered_map>
+#include <set>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <time.h>
+#endif
 
 // Forward declaration
 class Mediator;
@@ -39,11 +75,11 @@ class ComponentA : public Component {
 public:
     ComponentA(Mediator* med) : Component(med) {}
     void send(const std::string& message) override {
-        std::cout << "ComponentA sends: " << message << std::endl;
+        output() << "ComponentA sends: " << message << '\n';
         mediator->notify(this, message);
     }
     void receive(const std::string& message) override {
-        std::cout << "ComponentA receives: " << message << std::endl;
+        output() << "ComponentA receives: " << message << '\n';
     }
 };
 
@@ -52,11 +88,11 @@ class ComponentB : public Component {
 public:
     ComponentB(Mediator* med) : Component(med) {}
     void send(const std::string& message) override {
-        std::cout << "ComponentB sends: " << message << std::endl;
+        output() << "ComponentB sends: " << message << '\n';
         mediator->notify(this, message);
     }
     void receive(const std::string& message) override {
-        std::cout << "ComponentB receives: " << message << std::endl;
+        output() << "ComponentB receives: " << message << '\n';
     }
 };
 
@@ -80,6 +116,727 @@ public:
     }
 };
 
+// Immutable message body shared by every receiver of a message
+typedef std::shared_ptr<const std::string> Payload;
+
+inline Payload makePayload(const std::string& text) {
+    return std::make_shared<const std::string>(text);
+}
+
+class EventBus;
+
+// Component that talks through an EventBus on a topic of its choice
+class BusComponent : public Component {
+protected:
+    EventBus* bus;
+    std::string name;
+    int topic; // Topic this component publishes on
+public:
+    BusComponent(EventBus* eventBus, const std::string& componentName, int publishTopic);
+
+    void send(const std::string& message) override;
+    void publish(const Payload& payload); // Send an existing payload without copying it
+
+    void receive(const std::string& message) override {
+        output() << name << " receives: " << message << '\n';
+    }
+};
+
+// EventBus: Mediator that routes by topic through a compact topic -> subscribers table.
+// Subscriptions must be complete before messages are published; the routing table is built once,
+// by build() or by the first publish, and several threads may publish concurrently after that.
+class EventBus : public Mediator {
+private:
+    std::vector<std::pair<int, BusComponent*>> subscriptions; // Registration order
+    std::set<std::pair<int, BusComponent*>> subscribed;       // Ignores repeated subscriptions
+    // Routing table: subscribers of topic t are routes[offsets[t] .. offsets[t + 1])
+    std::vector<uint32_t> offsets;
+    std::mutex buildMutex;
+    std::atomic<bool> built;
+
+protected:
+    std::vector<BusComponent*> routes;
+
+    // Fill offsets and routes from the subscriptions; buildMutex is held
+    virtual void buildRoutes() {
+        int topicCount = 0;
+        for (const auto& subscription : subscriptions) {
+            topicCount = std::max(topicCount, subscription.first + 1);
+        }
+        offsets.assign(topicCount + 1, 0);
+        for (const auto& subscription : subscriptions) {
+            ++offsets[subscription.first + 1];
+        }
+        for (int t = 0; t < topicCount; ++t) {
+            offsets[t + 1] += offsets[t];
+        }
+        routes.resize(subscriptions.size());
+        std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (const auto& subscription : subscriptions) {
+            routes[cursor[subscription.first]++] = subscription.second;
+        }
+    }
+
+    // Call visit(routeIndex) for every subscriber of topic except the sender
+    template <typename Visit>
+    void forEachRoute(int topic, Component* sender, Visit visit) {
+        if (!built.load(std::memory_order_acquire)) {
+            build();
+        }
+        if (topic < 0 || topic + 1 >= static_cast<int>(offsets.size())) {
+            return; // No subscribers
+        }
+        for (uint32_t i = offsets[topic]; i < offsets[topic + 1]; ++i) {
+            if (routes[i] != sender) {
+                visit(i);
+            }
+        }
+    }
+
+public:
+    EventBus() : built(false) {}
+    virtual ~EventBus() {}
+
+    // Topics are non-negative; subscribing a component to a topic it already has is ignored
+    void subscribe(int topic, BusComponent* component) {
+        if (topic < 0) {
+            throw std::invalid_argument("event bus topics must be non-negative");
+        }
+        std::lock_guard<std::mutex> lock(buildMutex);
+        if (subscribed.insert(std::make_pair(topic, component)).second) {
+            subscriptions.emplace_back(topic, component);
+            built.store(false, std::memory_order_relaxed); // Routing table is rebuilt on the next publish
+        }
+    }
+
+    // Precompute the routing table; the first publish after subscriptions change calls it too.
+    // Concurrent first publishers wait here while one of them builds.
+    void build() {
+        std::lock_guard<std::mutex> lock(buildMutex);
+        if (!built.load(std::memory_order_relaxed)) {
+            buildRoutes();
+            built.store(true, std::memory_order_release);
+        }
+    }
+
+    // Deliver payload to every subscriber of topic except the sender; receivers share the payload
+    virtual void publish(int topic, Component* sender, const Payload& payload) {
+        const std::string& message = *payload;
+        forEachRoute(topic, sender, [&](uint32_t route) { routes[route]->receive(message); });
+    }
+
+    // Mediator interface: plain notifications are published on topic 0
+    void notify(Component* sender, const std::string& message) override {
+        publish(0, sender, makePayload(message));
+    }
+};
+
+BusComponent::BusComponent(EventBus* eventBus, const std::string& componentName, int publishTopic)
+    : Component(eventBus), bus(eventBus), name(componentName), topic(publishTopic) {}
+
+void BusComponent::send(const std::string& message) {
+    output() << name << " sends: " << message << '\n';
+    publish(makePayload(message));
+}
+
+void BusComponent::publish(const Payload& payload) {
+    bus->publish(topic, this, payload);
+}
+
+// Mailbox: Bounded lock-free MPSC queue of payloads for one component (Vyukov-style ring)
+class Mailbox {
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        Payload payload;
+        int64_t sentAt; // steady_clock nanoseconds, for latency measurement
+    };
+
+    std::vector<Cell> cells;
+    size_t mask;
+    char producerPadding[64];
+    std::atomic<size_t> tail; // Shared by producers
+    char consumerPadding[64];
+    std::atomic<size_t> head; // Written only by the worker draining the mailbox
+
+public:
+    BusComponent* owner;
+    std::atomic<bool> scheduled; // Queued on, or being drained by, the scheduler
+
+    Mailbox(BusComponent* component, size_t capacity)
+        : cells(capacity), mask(capacity - 1), tail(0), head(0), owner(component), scheduled(false) {
+        for (size_t i = 0; i < capacity; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool tryPush(const Payload& payload, int64_t sentAt) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[position & mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.payload = payload;
+                    cell.sentAt = sentAt;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0) {
+                return false; // Full
+            }
+            else {
+                position = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(Payload& payload, int64_t& sentAt) {
+        size_t position = head.load(std::memory_order_relaxed);
+        Cell& cell = cells[position & mask];
+        if (cell.sequence.load(std::memory_order_acquire) != position + 1) {
+            return false; // Empty (or the next message is still being written)
+        }
+        payload = std::move(cell.payload);
+        sentAt = cell.sentAt;
+        cell.sequence.store(position + mask + 1, std::memory_order_release);
+        head.store(position + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // May be called by any thread; a stale answer only causes a redundant schedule attempt
+    bool empty() const {
+        size_t position = head.load(std::memory_order_relaxed);
+        return cells[position & mask].sequence.load(std::memory_order_acquire) != position + 1;
+    }
+};
+
+// AsyncEventBus: Actor-style mode of the event bus; deliveries go to mailboxes drained by a thread pool
+class AsyncEventBus : public EventBus {
+public:
+    enum class Overflow {
+        Block, // Wait for space in a full mailbox (only from threads outside the pool)
+        Reject // Drop the delivery and count it
+    };
+
+private:
+    size_t mailboxCapacity;
+    Overflow overflow;
+    std::unordered_map<BusComponent*, std::unique_ptr<Mailbox>> mailboxes;
+    std::vector<Mailbox*> routeMailboxes; // Parallel to routes
+
+    std::mutex runMutex;
+    std::condition_variable runReady;
+    std::deque<Mailbox*> runQueue; // Mailboxes with messages waiting for a worker
+    bool stopping;
+    std::vector<std::thread> workers;
+
+    std::atomic<int64_t> pending;  // Messages pushed but not yet handled
+    std::atomic<uint64_t> rejected;
+    std::atomic<uint64_t> waits;   // Deliveries that had to wait for mailbox space
+    std::vector<std::vector<double>> latencySamples; // Per worker, microseconds
+
+    static int64_t nowNanos() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void schedule(Mailbox* mailbox) {
+        bool expected = false;
+        if (mailbox->scheduled.compare_exchange_strong(expected, true)) {
+            {
+                std::lock_guard<std::mutex> lock(runMutex);
+                runQueue.push_back(mailbox);
+            }
+            runReady.notify_one();
+        }
+    }
+
+    void work(size_t index) {
+        const int drainBatch = 64; // Messages per turn before yielding the worker to other mailboxes
+        std::vector<double>& latencies = latencySamples[index];
+        uint64_t sampleCounter = 0;
+        while (true) {
+            Mailbox* mailbox;
+            {
+                std::unique_lock<std::mutex> lock(runMutex);
+                runReady.wait(lock, [this] { return stopping || !runQueue.empty(); });
+                if (runQueue.empty()) {
+                    return;
+                }
+                mailbox = runQueue.front();
+                runQueue.pop_front();
+            }
+
+            Payload payload;
+            int64_t sentAt;
+            int handled = 0;
+            for (; handled < drainBatch && mailbox->tryPop(payload, sentAt); ++handled) {
+                mailbox->owner->receive(*payload);
+                if ((++sampleCounter & 15) == 0) {
+                    latencies.push_back((nowNanos() - sentAt) / 1000.0); // Sample 1 in 16
+                }
+            }
+            payload.reset();
+            pending.fetch_sub(handled, std::memory_order_release); // Last: waitIdle may return after this
+
+            // Release the mailbox, then re-check so a concurrent push is never left unscheduled
+            mailbox->scheduled.store(false);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!mailbox->empty()) {
+                schedule(mailbox);
+            }
+        }
+    }
+
+public:
+    AsyncEventBus(unsigned workerCount, size_t capacity = 1024, Overflow overflowPolicy = Overflow::Block)
+        : mailboxCapacity(1), overflow(overflowPolicy), stopping(false), pending(0), rejected(0), waits(0),
+          latencySamples(workerCount) {
+        while (mailboxCapacity < capacity) {
+            mailboxCapacity <<= 1; // Ring capacity must be a power of two
+        }
+        for (unsigned i = 0; i < workerCount; ++i) {
+            workers.emplace_back([this, i] { work(i); });
+        }
+    }
+
+    ~AsyncEventBus() {
+        waitIdle();
+        {
+            std::lock_guard<std::mutex> lock(runMutex);
+            stopping = true;
+        }
+        runReady.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    // Also gives every routed component its mailbox
+    void buildRoutes() override {
+        EventBus::buildRoutes();
+        routeMailboxes.clear();
+        for (BusComponent* component : routes) {
+            std::unique_ptr<Mailbox>& mailbox = mailboxes[component];
+            if (!mailbox) {
+                mailbox.reset(new Mailbox(component, mailboxCapacity));
+            }
+            routeMailboxes.push_back(mailbox.get());
+        }
+    }
+
+    void publish(int topic, Component* sender, const Payload& payload) override {
+        int64_t sentAt = nowNanos();
+        forEachRoute(topic, sender, [&](uint32_t route) {
+            Mailbox* mailbox = routeMailboxes[route];
+            pending.fetch_add(1, std::memory_order_relaxed);
+            if (!mailbox->tryPush(payload, sentAt)) {
+                if (overflow == Overflow::Reject) {
+                    pending.fetch_sub(1, std::memory_order_relaxed);
+                    rejected.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                waits.fetch_add(1, std::memory_order_relaxed);
+                do {
+                    schedule(mailbox); // Make sure a worker is draining it
+                    std::this_thread::yield();
+                } while (!mailbox->tryPush(payload, sentAt));
+            }
+            std::atomic_thread_fence(std::memory_order_seq_cst); // Pairs with the worker's re-check
+            if (!mailbox->scheduled.load()) {
+                schedule(mailbox);
+            }
+        });
+    }
+
+    // Block until every published message has been handled
+    void waitIdle() {
+        while (pending.load(std::memory_order_acquire) > 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    uint64_t rejectedCount() const { return rejected.load(); }
+    uint64_t waitCount() const { return waits.load(); }
+
+    // Sampled end-to-end latencies in microseconds; only valid while idle
+    std::vector<double> latencies() const {
+        std::vector<double> all;
+        for (const auto& samples : latencySamples) {
+            all.insert(all.end(), samples.begin(), samples.end());
+        }
+        return all;
+    }
+};
+
+#ifdef __linux__
+// SharedRing: Single-producer single-consumer ring of fixed-size message slots, placed in shared
+// memory. head and tail double as futex words so a blocked side sleeps in the kernel.
+struct SharedRing {
+    static const uint32_t slotCount = 1024; // Power of two
+    static const uint32_t slotSize = 128;
+    static const uint32_t maxMessage = slotSize - sizeof(uint32_t);
+
+    struct Slot {
+        uint32_t length;
+        char data[maxMessage];
+    };
+
+    alignas(64) std::atomic<uint32_t> head;      // Next slot to read, written by the consumer
+    alignas(64) std::atomic<uint32_t> tail;      // Next slot to write, written by the producer
+    alignas(64) std::atomic<uint32_t> consumerWaiting;
+    std::atomic<uint32_t> producerWaiting;
+    Slot slots[slotCount];
+};
+
+// Futex helpers on words shared between processes (no FUTEX_PRIVATE_FLAG). Waits are bounded so
+// a side blocked on a peer that died wakes up and notices.
+inline void futexWait(std::atomic<uint32_t>& word, uint32_t expected, long timeoutNanos) {
+    timespec timeout = { timeoutNanos / 1000000000L, timeoutNanos % 1000000000L };
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+}
+
+inline void futexWake(std::atomic<uint32_t>& word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+}
+
+// SharedMemoryMediator: Mediator between one local component and a peer in another process.
+// The segment holds one ring per direction; the creating side writes ring 0 and reads ring 1.
+class SharedMemoryMediator : public Mediator {
+private:
+    std::string name;
+    bool owner; // Created (and will unlink) the segment
+    SharedRing* rings;
+    SharedRing* outbound;
+    SharedRing* inbound;
+    Component* local;
+    pid_t parent;      // Parent process this side was forked from, or 0 when not watching it
+    pid_t child;       // Child process on the other side, or 0 when not watching it
+    bool childExited;  // child has been reaped by peerExited()
+
+    static const int spinLimit = 1000;               // Busy-poll this many times before sleeping on the futex
+    static const long waitTimeout = 100000000L;      // Nanoseconds per futex sleep before rechecking the peer
+
+    // Called after each futex sleep: true once the watched peer process has gone away. The caller
+    // rechecks the ring afterwards, so messages the peer wrote before exiting are still delivered.
+    bool peerExited() {
+        if (parent != 0 && getppid() != parent) {
+            return true;
+        }
+        if (child != 0 && !childExited) {
+            int status = 0;
+            childExited = waitpid(child, &status, WNOHANG) == child;
+        }
+        return childExited;
+    }
+
+public:
+    // create = true makes a fresh segment; the peer process opens it by the same name
+    SharedMemoryMediator(const std::string& segmentName, bool create)
+        : name(segmentName), owner(create), rings(nullptr), local(nullptr), parent(0), child(0), childExited(false) {
+        int fd = shm_open(name.c_str(), create ? (O_CREAT | O_EXCL | O_RDWR) : O_RDWR, 0600);
+        if (fd < 0) {
+            throw std::runtime_error("shm_open failed for " + name);
+        }
+        size_t size = 2 * sizeof(SharedRing);
+        if (create && ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            close(fd);
+            shm_unlink(name.c_str());
+            throw std::runtime_error("ftruncate failed for " + name);
+        }
+        void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (memory == MAP_FAILED) {
+            throw std::runtime_error("mmap failed for " + name);
+        }
+        rings = static_cast<SharedRing*>(memory);
+        if (create) {
+            for (int i = 0; i < 2; ++i) {
+                new (&rings[i].head) std::atomic<uint32_t>(0);
+                new (&rings[i].tail) std::atomic<uint32_t>(0);
+                new (&rings[i].consumerWaiting) std::atomic<uint32_t>(0);
+                new (&rings[i].producerWaiting) std::atomic<uint32_t>(0);
+            }
+        }
+        outbound = &rings[create ? 0 : 1];
+        inbound = &rings[create ? 1 : 0];
+    }
+
+    ~SharedMemoryMediator() {
+        munmap(rings, 2 * sizeof(SharedRing));
+        if (owner) {
+            shm_unlink(name.c_str());
+        }
+    }
+
+    SharedMemoryMediator(const SharedMemoryMediator&) = delete;
+    SharedMemoryMediator& operator=(const SharedMemoryMediator&) = delete;
+
+    void attach(Component* component) { local = component; }
+
+    // Call in a forked child: blocking sends and receives throw once the parent process exits
+    // instead of waiting forever for it
+    void watchParent() { parent = getppid(); }
+
+    // Call in the parent after fork: blocking sends and receives throw once that child exits. The
+    // child is reaped when that is detected, so a later waitpid for it may fail with ECHILD.
+    void watchChild(pid_t forked) { child = forked; }
+
+    // Copy one message into the next outbound slot, waiting while the ring is full
+    void send(const char* data, size_t length) {
+        if (length > SharedRing::maxMessage) {
+            throw std::length_error("message larger than a shared-memory slot");
+        }
+        uint32_t tail = outbound->tail.load(std::memory_order_relaxed);
+        for (int spins = 0; tail - outbound->head.load(std::memory_order_acquire) == SharedRing::slotCount; ++spins) {
+            if (spins < spinLimit) {
+                continue;
+            }
+            uint32_t head = outbound->head.load();
+            outbound->producerWaiting.store(1);
+            if (tail - outbound->head.load() == SharedRing::slotCount) {
+                futexWait(outbound->head, head, waitTimeout);
+            }
+            outbound->producerWaiting.store(0);
+            if (peerExited() && tail - outbound->head.load() == SharedRing::slotCount) {
+                throw std::runtime_error("shared-memory peer process exited");
+            }
+        }
+        SharedRing::Slot& slot = outbound->slots[tail & (SharedRing::slotCount - 1)];
+        slot.length = static_cast<uint32_t>(length);
+        std::memcpy(slot.data, data, length);
+        outbound->tail.store(tail + 1); // Sequentially consistent: pairs with the consumer's waiting flag
+        if (outbound->consumerWaiting.load()) {
+            futexWake(outbound->tail);
+        }
+    }
+
+    // Wait for the next inbound message and pass visit a view of it, still inside the slot
+    template <typename Visit>
+    void receive(Visit visit) {
+        uint32_t head = inbound->head.load(std::memory_order_relaxed);
+        for (int spins = 0; inbound->tail.load(std::memory_order_acquire) == head; ++spins) {
+            if (spins < spinLimit) {
+                continue;
+            }
+            inbound->consumerWaiting.store(1);
+            if (inbound->tail.load() == head) {
+                futexWait(inbound->tail, head, waitTimeout);
+            }
+            inbound->consumerWaiting.store(0);
+            if (peerExited() && inbound->tail.load() == head) {
+                throw std::runtime_error("shared-memory peer process exited");
+            }
+        }
+        const SharedRing::Slot& slot = inbound->slots[head & (SharedRing::slotCount - 1)];
+        visit(slot.data, static_cast<size_t>(slot.length));
+        inbound->head.store(head + 1); // Releases the slot back to the producer
+        if (inbound->producerWaiting.load()) {
+            futexWake(inbound->head);
+        }
+    }
+
+    // Deliver the next inbound message to the attached component
+    void pump() {
+        receive([this](const char* data, size_t length) { local->receive(std::string(data, length)); });
+    }
+
+    // Mediator interface: anything the local component sends goes to the peer process
+    void notify(Component*, const std::string& message) override {
+        send(message.data(), message.size());
+    }
+};
+
+// Benchmark: two-process throughput and round-trip latency over shared memory
+void benchmarkSharedMemory() {
+    using Clock = std::chrono::steady_clock;
+    const int streamCount = 1000000;
+    const int pingCount = 100000;
+    const std::string segment = "/mediator_benchmark_" + std::to_string(getpid());
+    const std::string message(64, 'x');
+
+    SharedMemoryMediator parent(segment, true);
+    flushOutput(); // The child inherits this process's output buffer
+    pid_t child = fork();
+    if (child < 0) {
+        output() << "Shared memory: fork failed, benchmark skipped\n";
+        flushOutput();
+        return;
+    }
+    if (child == 0) {
+        // Peer process: consume the stream, acknowledge it, then echo every ping
+        int status = 0;
+        try {
+            SharedMemoryMediator peer(segment, false);
+            peer.watchParent();
+            uint64_t bytes = 0;
+            for (int i = 0; i < streamCount; ++i) {
+                peer.receive([&bytes](const char*, size_t length) { bytes += length; });
+            }
+            peer.send("done", 4);
+            char echo[SharedRing::maxMessage];
+            for (int i = 0; i < pingCount; ++i) {
+                size_t length = 0;
+                peer.receive([&](const char* data, size_t size) { std::memcpy(echo, data, size); length = size; });
+                peer.send(echo, length);
+            }
+        }
+        catch (...) {
+            status = 1;
+        }
+        _exit(status); // Skip this process's copy of the parent's exit handlers and buffers
+    }
+
+    parent.watchChild(child);
+
+    double seconds = 0;
+    std::vector<double> roundTrips;
+    roundTrips.reserve(pingCount);
+    try {
+        auto start = Clock::now();
+        for (int i = 0; i < streamCount; ++i) {
+            parent.send(message.data(), message.size());
+        }
+        parent.receive([](const char*, size_t) {}); // Wait for "done"
+        seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        for (int i = 0; i < pingCount; ++i) {
+            auto sent = Clock::now();
+            parent.send(message.data(), message.size());
+            parent.receive([](const char*, size_t) {});
+            roundTrips.push_back(std::chrono::duration<double, std::micro>(Clock::now() - sent).count());
+        }
+    }
+    catch (const std::exception& error) {
+        output() << "Shared memory benchmark failed: " << error.what() << '\n';
+        flushOutput();
+        return;
+    }
+    waitpid(child, nullptr, 0);
+
+    std::sort(roundTrips.begin(), roundTrips.end());
+    output() << "Shared memory, 2 processes: " << streamCount / seconds / 1e6 << " M messages/s, round trip p50 "
+             << roundTrips[pingCount / 2] << " us, p99 " << roundTrips[pingCount * 99 / 100] << " us\n";
+    flushOutput();
+}
+#else
+void benchmarkSharedMemory() {
+    output() << "Shared-memory mediator requires Linux (POSIX shared memory and futexes)\n";
+}
+#endif
+
+// Benchmark component: counts deliveries instead of printing them
+class CountingComponent : public BusComponent {
+public:
+    uint64_t received = 0;
+    uint64_t bytes = 0;
+    using BusComponent::BusComponent;
+    void receive(const std::string& message) override {
+        ++received;
+        bytes += message.size();
+    }
+};
+
+// Benchmark: messages per second through the event bus with 10 to 10,000 components
+void benchmarkEventBus() {
+    using Clock = std::chrono::steady_clock;
+    const int messageCount = 1000000;
+    const int subscriptionsPerComponent = 4;
+
+    for (int componentCount : { 10, 100, 1000, 10000 }) {
+        EventBus bus;
+        int topicCount = std::max(1, componentCount / 4);
+        std::vector<std::unique_ptr<CountingComponent>> components;
+        uint64_t seed = 12345;
+        auto random = [&seed] {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            return static_cast<int>(seed >> 33);
+        };
+        for (int i = 0; i < componentCount; ++i) {
+            components.emplace_back(new CountingComponent(&bus, "C" + std::to_string(i), random() % topicCount));
+            for (int s = 0; s < subscriptionsPerComponent; ++s) {
+                bus.subscribe(random() % topicCount, components.back().get());
+            }
+        }
+        bus.build();
+
+        Payload payload = makePayload(std::string(256, 'x')); // One buffer shared by all messages
+        auto start = Clock::now();
+        for (int m = 0; m < messageCount; ++m) {
+            components[m % componentCount]->publish(payload);
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        uint64_t deliveries = 0;
+        for (const auto& component : components) {
+            deliveries += component->received;
+        }
+        output() << componentCount << " components: " << messageCount / seconds / 1e6 << " M messages/s, "
+                 << deliveries / seconds / 1e6 << " M deliveries/s\n";
+    }
+    flushOutput();
+}
+
+// Benchmark: scaling of the actor-style bus across worker threads, with end-to-end latency percentiles
+void benchmarkAsyncEventBus() {
+    using Clock = std::chrono::steady_clock;
+    const int componentCount = 1000;
+    const int topicCount = 250;
+    const int producerCount = 2;
+    const int messagesPerProducer = 200000;
+
+    unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> workerCounts = { 1, 2, 4 };
+    if (hardwareThreads > 4) {
+        workerCounts.push_back(hardwareThreads);
+    }
+    for (unsigned workerCount : workerCounts) {
+        std::vector<std::unique_ptr<CountingComponent>> components;
+        uint64_t deliveries = 0;
+        double seconds;
+        std::vector<double> latencies;
+        uint64_t waits;
+        {
+            AsyncEventBus bus(workerCount, 256);
+            for (int i = 0; i < componentCount; ++i) {
+                components.emplace_back(new CountingComponent(&bus, "C" + std::to_string(i), i % topicCount));
+                bus.subscribe((i * 7) % topicCount, components.back().get());
+                bus.subscribe((i * 13 + 1) % topicCount, components.back().get());
+            }
+            bus.build();
+
+            Payload payload = makePayload(std::string(64, 'x'));
+            auto start = Clock::now();
+            std::vector<std::thread> producers;
+            for (int p = 0; p < producerCount; ++p) {
+                producers.emplace_back([&, p] {
+                    for (int m = 0; m < messagesPerProducer; ++m) {
+                        components[(m * producerCount + p) % componentCount]->publish(payload);
+                    }
+                });
+            }
+            for (auto& producer : producers) {
+                producer.join();
+            }
+            bus.waitIdle();
+            seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            latencies = bus.latencies();
+            waits = bus.waitCount();
+        }
+        for (const auto& component : components) {
+            deliveries += component->received;
+        }
+        std::sort(latencies.begin(), latencies.end());
+        output() << workerCount << " worker(s): " << deliveries / seconds / 1e6 << " M deliveries/s, "
+                 << "p50 " << latencies[latencies.size() / 2] << " us, p99 " << latencies[latencies.size() * 99 / 100]
+                 << " us, " << waits << " backpressure waits\n";
+        flushOutput();
+    }
+}
+
 // Main function to demonstrate the Mediator pattern
 int main() {
 	// Create mediator and components
@@ -95,5 +852,77 @@ int main() {
     a.send("Hello from A!");
     b.send("Hi from B!");
 
+    // Topic-based communication via the event bus
+    EventBus bus;
+    BusComponent sensor(&bus, "Sensor", 1);
+    BusComponent logger(&bus, "Logger", 2);
+    BusComponent display(&bus, "Display", 2);
+    bus.subscribe(1, &logger);  // Logger and Display listen to sensor readings
+    bus.subscribe(1, &display);
+    bus.subscribe(2, &sensor);  // Sensor listens to commands
+    sensor.send("temperature=21");
+    display.send("refresh");
+
+    // Actor-style delivery: receivers run on the bus's worker threads
+    flushOutput(); // Everything above comes first; workers flush their own output
+    {
+        AsyncEventBus asyncBus(2);
+        BusComponent producer(&asyncBus, "Producer", 3);
+        BusComponent consumer(&asyncBus, "Consumer", 4);
+        asyncBus.subscribe(3, &consumer);
+        producer.send("job 1");
+        producer.send("job 2"); // Handled after job 1: one component's mailbox is processed in order
+        flushOutput();
+        asyncBus.waitIdle();
+    }
+
+#ifdef __linux__
+    // Cross-process communication: ComponentB lives in a child process
+    {
+        const std::string segment = "/mediator_demo_" + std::to_string(getpid());
+        SharedMemoryMediator local(segment, true);
+        ComponentA localA(&local);
+        local.attach(&localA);
+        flushOutput();
+        pid_t child = fork();
+        if (child < 0) {
+            output() << "fork failed, cross-process demo skipped\n";
+        }
+        else if (child == 0) {
+            int status = 0;
+            try {
+                SharedMemoryMediator remote(segment, false);
+                remote.watchParent();
+                ComponentB remoteB(&remote);
+                remote.attach(&remoteB);
+                remote.pump();           // Receive A's greeting in this process
+                remoteB.send("Hi from another process!");
+                flushOutput();
+            }
+            catch (...) {
+                status = 1;
+            }
+            _exit(status);
+        }
+        else {
+            local.watchChild(child);
+            try {
+                localA.send("Hello across processes!");
+                flushOutput();
+                local.pump();            // Receive B's reply
+            }
+            catch (const std::exception& error) {
+                output() << "Cross-process demo failed: " << error.what() << '\n';
+            }
+            waitpid(child, nullptr, 0);
+        }
+        flushOutput();
+    }
+#endif
+
+    benchmarkEventBus();
+    benchmarkAsyncEventBus();
+    benchmarkSharedMemory();
+
     return 0;
 }
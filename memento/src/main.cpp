@@ -10,7 +10,7 @@
 */
 
 // Include necessary headers
-#include <iostream>
+#include "../../common/output_sink.h"
 #include <vector>
 
 // Memento class - Stores a snapshot of the Originator's state
@@ -29,14 +29,14 @@ private:
 public:
     void setState(int s) { // Modify the state
         state = s;
-        std::cout << "State set to: " << state << std::endl;
+        output() << "State set to: " << state << '\n';
     }
     Memento saveToMemento() { // Save current state to Memento
         return Memento(state);
     }
     void restoreFromMemento(const Memento& m) { // Restore state from Memento
         state = m.getState();
-        std::cout << "State restored to: " << state << std::endl;
+        output() << "State restored to: " << state << '\n';
     }
 };
 
@@ -11,8 +11,10 @@
 */
 
 // Include necessary headers
-#include <iostream>
+#include "../../common/output_sink.h"
 #include <vector>
+#include <algorithm>
+#include <chrono>
 
 // Forward declaration of Subject to avoid circular dependency
 class Subject;
@@ -36,7 +38,7 @@ public:
     }
 
     void detach(Observer* observer) {
-        observers.erase(remove(observers.begin(), observers.end(), observer), observers.end());
+        observers.erase(std::remove(observers.begin(), observers.end(), observer), observers.end());
     }
 
     void notify() {
@@ -58,10 +60,33 @@ private:
 public:
     ConcreteObserver(int id) : observerID(id) {}
     void update(int state) override {
-        std::cout << "Observer " << observerID << " notified. New state: " << state << std::endl;
+        output() << "Observer " << observerID << " notified. New state: " << state << '\n';
     }
 };
 
+// Benchmark: notification events per second through the console sink and the null sink
+void benchmarkSinks() {
+    using Clock = std::chrono::steady_clock;
+    Subject subject;
+    ConcreteObserver observer(1);
+    subject.attach(&observer);
+
+    auto eventsPerSecond = [&](OutputSink& sink, int events) {
+        setOutputSink(sink);
+        auto start = Clock::now();
+        for (int i = 0; i < events; ++i) {
+            subject.setState(i);
+        }
+        flushOutput();
+        return events / std::chrono::duration<double>(Clock::now() - start).count();
+    };
+
+    double console = eventsPerSecond(consoleSink(), 100000);
+    double discarded = eventsPerSecond(nullSink(), 10000000);
+    setOutputSink(consoleSink());
+    output() << "Console sink: " << console << " events/s, null sink: " << discarded << " events/s\n";
+}
+
 // Main function to demonstrate the pattern
 int main() {
     Subject subject; // Create a Subject
@@ -75,13 +100,15 @@ int main() {
     subject.attach(&observer2);
 
     // Change subject state and notify observers
-    std::cout << "Setting state to 10" << std::endl;
+    output() << "Setting state to 10\n";
     subject.setState(10);
 
     // Detach one observer and change state again
     subject.detach(&observer1);
-    std::cout << "Setting state to 20" << std::endl;
+    output() << "Setting state to 20\n";
     subject.setState(20);
 
+    benchmarkSinks();
+
     return 0;
 }
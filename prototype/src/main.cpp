@@ -5,7 +5,7 @@
 */
 
 // Include the necessary headers
-#include <iostream>
+#include "../../common/output_sink.h"
 #include <memory>
 
  // Define the Prototype Interface
@@ -29,7 +29,7 @@ public:
     }
 
     void show() const override {
-        std::cout << "ConcretePrototypeA with value: " << value << std::endl;
+        output() << "ConcretePrototypeA with value: " << value << '\n';
     }
 };
 
@@ -1,55 +1,697 @@
 /*
     Proxy: Provides a surrogate or placeholder for another object to control access to it.
+
+           Variants shown here:
+           - Proxy: Virtual proxy with once-only thread-safe lazy creation and an optional
+                    background warm-up so the first caller does not pay construction cost.
+           - CachingProxy: Memoizes request results in a sharded LRU cache.
+           - SingleFlightProxy: Concurrent identical requests share one in-flight execution.
+           - BatchingProxy: Collects requests for a short window and forwards them as one batch.
+           - AdmissionProxy: Rate limits with a lock-free token bucket, caps concurrency and sheds
+                             load beyond a bounded wait queue.
 */
 
 // Include necessary headers
-#include <iostream>
+#include "../../common/output_sink.h"
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <condition_variable>
+#include <future>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
 
 // Subject Interface
 class Subject {
 public:
-    virtual void request() = 0; // Pure virtual function
+    virtual void request() = 0;            // Pure virtual function
+    virtual uint64_t request(int key) = 0; // Keyed request returning a result
+    virtual std::vector<uint64_t> requestBatch(const std::vector<int>& keys) {
+        // Default batch: one request per key; subjects with a real batch path override this
+        std::vector<uint64_t> results;
+        results.reserve(keys.size());
+        for (int key : keys) {
+            results.push_back(request(key));
+        }
+        return results;
+    }
     virtual ~Subject() {}
 };
 
 // RealSubject: The actual object that performs the real work
 class RealSubject : public Subject {
 public:
+    RealSubject() {
+        // Simulate an expensive setup (connections, loading resources, ...)
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
     void request() override {
-        std::cout << "RealSubject: Handling request.\n";
+        output() << "RealSubject: Handling request.\n";
+    }
+
+    uint64_t request(int key) override {
+        // Simulate an expensive computation for the given key
+        uint64_t value = static_cast<uint64_t>(key);
+        for (int i = 0; i < 2000; ++i) {
+            value = value * 6364136223846793005ull + 1442695040888963407ull;
+        }
+        return value;
     }
 };
 
 // Proxy: Controls access to RealSubject
 class Proxy : public Subject {
 private:
-    RealSubject* realSubject; // Pointer to the real object
+    std::unique_ptr<RealSubject> realSubject; // Created exactly once, on first use or warm-up
+    std::once_flag created;
+    std::mutex warmUpMutex; // Guards warmUpThread, so warmUp() may race with itself and request()
+    std::thread warmUpThread;
+
+    RealSubject& getRealSubject() {
+        // Lazy initialization: concurrent first callers block until the single creation finishes
+        std::call_once(created, [this] {
+            output() << "Proxy: Creating RealSubject instance.\n";
+            realSubject.reset(new RealSubject());
+        });
+        return *realSubject;
+    }
 
 public:
-    Proxy() : realSubject(nullptr) {} // Constructor initializes to null
+    Proxy() {} // RealSubject is created lazily
 
     ~Proxy() {
-        delete realSubject; // Cleanup memory when proxy is destroyed
+        std::lock_guard<std::mutex> lock(warmUpMutex);
+        if (warmUpThread.joinable()) {
+            warmUpThread.join(); // Never destroy the proxy while warm-up is still running
+        }
+    }
+
+    // Start creating RealSubject in the background; later requests reuse it. Safe to call from
+    // any thread, concurrently with request() or other warmUp() calls; only the first starts a thread.
+    void warmUp() {
+        std::lock_guard<std::mutex> lock(warmUpMutex);
+        if (!warmUpThread.joinable()) {
+            warmUpThread = std::thread([this] { getRealSubject(); });
+        }
+    }
+
+    void request() override {
+        RealSubject& subject = getRealSubject();
+        output() << "Proxy: Forwarding request to RealSubject.\n";
+        subject.request();
+    }
+
+    uint64_t request(int key) override {
+        return getRealSubject().request(key);
+    }
+};
+
+// CachingProxy: Memoizes keyed results in a sharded LRU, so hot keys skip the real subject
+class CachingProxy : public Subject {
+private:
+    // Each shard is an independent LRU with its own lock, keeping contention low
+    struct Shard {
+        std::mutex mutex;
+        std::list<std::pair<int, uint64_t>> entries; // Most recently used at the front
+        std::unordered_map<int, std::list<std::pair<int, uint64_t>>::iterator> index;
+    };
+
+    Subject& subject;
+    size_t shardCapacity;
+    std::vector<Shard> shards;
+    std::atomic<uint64_t> hits;
+    std::atomic<uint64_t> misses;
+
+    Shard& shardFor(int key) {
+        uint64_t hash = static_cast<uint64_t>(static_cast<uint32_t>(key)) * 0x9E3779B97F4A7C15ull;
+        return shards[(hash >> 32) % shards.size()];
+    }
+
+public:
+    CachingProxy(Subject& subj, size_t capacity, size_t shardCount = 16)
+        : subject(subj), shardCapacity(capacity / std::max<size_t>(shardCount, 1) + 1), shards(shardCount), hits(0), misses(0) {
+        if (shardCount == 0) {
+            throw std::invalid_argument("CachingProxy needs at least one shard");
+        }
+    }
+
+    void request() override {
+        subject.request(); // Un-keyed requests have nothing to cache
+    }
+
+    uint64_t request(int key) override {
+        Shard& shard = shardFor(key);
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto found = shard.index.find(key);
+            if (found != shard.index.end()) {
+                shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+                hits.fetch_add(1, std::memory_order_relaxed);
+                return found->second->second;
+            }
+        }
+
+        // Compute outside the lock so a slow backend does not block the whole shard
+        misses.fetch_add(1, std::memory_order_relaxed);
+        uint64_t value = subject.request(key);
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.index.find(key) == shard.index.end()) {
+            shard.entries.emplace_front(key, value);
+            shard.index[key] = shard.entries.begin();
+            if (shard.entries.size() > shardCapacity) {
+                shard.index.erase(shard.entries.back().first); // Evict least recently used
+                shard.entries.pop_back();
+            }
+        }
+        return value;
+    }
+
+    uint64_t hitCount() const { return hits.load(std::memory_order_relaxed); }
+    uint64_t missCount() const { return misses.load(std::memory_order_relaxed); }
+};
+
+// SingleFlightProxy: Concurrent requests for the same key share one call to the subject
+class SingleFlightProxy : public Subject {
+private:
+    Subject& subject;
+    std::mutex mutex;
+    std::unordered_map<int, std::shared_future<uint64_t>> inFlight; // Key -> pending result
+
+public:
+    SingleFlightProxy(Subject& subj) : subject(subj) {}
+
+    void request() override {
+        subject.request();
+    }
+
+    uint64_t request(int key) override {
+        std::promise<uint64_t> promise;
+        std::shared_future<uint64_t> result;
+        bool leader = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto found = inFlight.find(key);
+            if (found != inFlight.end()) {
+                result = found->second; // Join the call already in flight
+            }
+            else {
+                result = promise.get_future().share();
+                inFlight.emplace(key, result);
+                leader = true;
+            }
+        }
+
+        if (leader) {
+            // Execute once and publish the result to every waiter
+            try {
+                promise.set_value(subject.request(key));
+            }
+            catch (...) {
+                promise.set_exception(std::current_exception());
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            inFlight.erase(key);
+        }
+        return result.get();
+    }
+};
+
+// BatchingProxy: Queues requests for a configurable window, then forwards them as one batch
+class BatchingProxy : public Subject {
+private:
+    struct Pending {
+        int key;
+        std::promise<uint64_t> promise;
+    };
+
+    Subject& subject;
+    std::chrono::microseconds window;
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::vector<Pending> pending;
+    bool stopping;
+    std::thread collector;
+
+    void collect() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wakeUp.wait(lock, [this] { return stopping || !pending.empty(); });
+            if (pending.empty()) {
+                return; // Stopping with nothing left to flush
+            }
+            // The first request opens the window; everything arriving within it joins the batch
+            wakeUp.wait_for(lock, window, [this] { return stopping; });
+            std::vector<Pending> batch;
+            batch.swap(pending);
+            lock.unlock();
+            flush(batch);
+            lock.lock();
+        }
+    }
+
+    void flush(std::vector<Pending>& batch) {
+        // Identical keys within a batch are forwarded once
+        std::vector<int> keys;
+        keys.reserve(batch.size());
+        for (const Pending& item : batch) {
+            keys.push_back(item.key);
+        }
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+        try {
+            std::vector<uint64_t> values = subject.requestBatch(keys);
+            for (Pending& item : batch) {
+                size_t at = std::lower_bound(keys.begin(), keys.end(), item.key) - keys.begin();
+                item.promise.set_value(values[at]);
+            }
+        }
+        catch (...) {
+            for (Pending& item : batch) {
+                item.promise.set_exception(std::current_exception());
+            }
+        }
+    }
+
+public:
+    BatchingProxy(Subject& subj, std::chrono::microseconds batchWindow)
+        : subject(subj), window(batchWindow), stopping(false) {
+        collector = std::thread([this] { collect(); });
+    }
+
+    ~BatchingProxy() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeUp.notify_all();
+        collector.join();
+    }
+
+    void request() override {
+        subject.request();
+    }
+
+    uint64_t request(int key) override {
+        std::future<uint64_t> result;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.push_back(Pending{ key, std::promise<uint64_t>() });
+            result = pending.back().promise.get_future();
+        }
+        wakeUp.notify_one();
+        return result.get();
+    }
+};
+
+// Thrown by AdmissionProxy when a request is shed instead of forwarded
+class AdmissionRejected : public std::runtime_error {
+public:
+    AdmissionRejected(const char* reason) : std::runtime_error(reason) {}
+};
+
+// AdmissionProxy: Protects a subject with a rate limit, a concurrency limit and a bounded queue
+class AdmissionProxy : public Subject {
+public:
+    struct Limits {
+        double ratePerSecond = 1000.0;              // Sustained token refill rate
+        double burst = 100.0;                       // Bucket size
+        int maxConcurrency = 8;                     // Requests allowed inside the subject at once
+        int maxQueue = 16;                          // Requests allowed to wait for a free slot
+        std::chrono::microseconds maxQueueWait{ 5000 }; // Waiting longer than this is shed too
+    };
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Subject& subject;
+    Limits limits;
+    int64_t tokenInterval; // Nanoseconds of refill per token
+    int64_t burstWindow;   // Nanoseconds of credit the bucket can hold
+    Clock::time_point epoch;
+
+    // Token bucket kept as a single "theoretical arrival time" (GCRA), updated with CAS
+    std::atomic<int64_t> nextFree;
+    std::atomic<int> inFlight;
+    std::atomic<int> queued;
+    std::atomic<uint64_t> rateRejected;
+    std::atomic<uint64_t> overloadRejected;
+    std::mutex queueMutex;
+    std::condition_variable slotFreed;
+
+    int64_t nowNanos() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - epoch).count();
+    }
+
+    bool takeToken() {
+        int64_t now = nowNanos();
+        int64_t current = nextFree.load(std::memory_order_relaxed);
+        while (true) {
+            int64_t next = std::max(current, now) + tokenInterval;
+            if (next - now > burstWindow) {
+                return false; // Bucket empty
+            }
+            if (nextFree.compare_exchange_weak(current, next, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+
+    // Give back a token taken by a request that was shed afterwards
+    void refundToken() {
+        nextFree.fetch_sub(tokenInterval, std::memory_order_relaxed);
+    }
+
+    // A waiter publishes itself in queued and then reads inFlight, while leave() decrements
+    // inFlight and then reads queued. Both sides use seq_cst so at least one sees the other;
+    // with weaker orders the waiter could miss the free slot and leave() could skip the notify.
+    bool tryEnter() {
+        int current = inFlight.load();
+        while (current < limits.maxConcurrency) {
+            if (inFlight.compare_exchange_weak(current, current + 1)) {
+                return true;
+            }
+        }
+        return false;
     }
 
+    bool enter() {
+        if (tryEnter()) {
+            return true; // Fast path: no locks while below the concurrency limit
+        }
+        if (queued.fetch_add(1) >= limits.maxQueue) {
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return false; // Queue full: shed immediately
+        }
+        std::unique_lock<std::mutex> lock(queueMutex);
+        bool entered = slotFreed.wait_for(lock, limits.maxQueueWait, [this] { return tryEnter(); });
+        queued.fetch_sub(1, std::memory_order_relaxed);
+        return entered;
+    }
+
+    void leave() {
+        inFlight.fetch_sub(1);
+        if (queued.load() > 0) {
+            std::lock_guard<std::mutex> lock(queueMutex); // Pairs with the waiter's predicate check
+            slotFreed.notify_one();
+        }
+    }
+
+public:
+    AdmissionProxy(Subject& subj, const Limits& admissionLimits)
+        : subject(subj), limits(admissionLimits),
+          tokenInterval(static_cast<int64_t>(1e9 / admissionLimits.ratePerSecond)),
+          burstWindow(static_cast<int64_t>(1e9 / admissionLimits.ratePerSecond * admissionLimits.burst)),
+          epoch(Clock::now()), nextFree(0), inFlight(0), queued(0), rateRejected(0), overloadRejected(0) {}
+
     void request() override {
-        // Lazy initialization: Only create RealSubject when needed
-        if (!realSubject) {
-            std::cout << "Proxy: Creating RealSubject instance.\n";
-            realSubject = new RealSubject();
+        request(0);
+    }
+
+    uint64_t request(int key) override {
+        if (!takeToken()) {
+            rateRejected.fetch_add(1, std::memory_order_relaxed);
+            throw AdmissionRejected("rate limit exceeded");
         }
+        if (!enter()) {
+            refundToken(); // Shedding for overload must not also count against the rate
+            overloadRejected.fetch_add(1, std::memory_order_relaxed);
+            throw AdmissionRejected("backend saturated");
+        }
+        try {
+            uint64_t value = subject.request(key);
+            leave();
+            return value;
+        }
+        catch (...) {
+            leave();
+            throw;
+        }
+    }
+
+    uint64_t rateRejectedCount() const { return rateRejected.load(std::memory_order_relaxed); }
+    uint64_t overloadRejectedCount() const { return overloadRejected.load(std::memory_order_relaxed); }
+};
+
+// SlowBackend: Simulated remote subject with a fixed per-call latency and a call counter
+class SlowBackend : public Subject {
+private:
+    std::chrono::microseconds latency;
+    std::atomic<uint64_t> calls;
+
+public:
+    SlowBackend(std::chrono::microseconds callLatency) : latency(callLatency), calls(0) {}
+
+    void request() override {
+        request(0);
+    }
+
+    uint64_t request(int key) override {
+        calls.fetch_add(1, std::memory_order_relaxed);
+        std::this_thread::sleep_for(latency);
+        return static_cast<uint64_t>(key) * 2654435761u;
+    }
+
+    std::vector<uint64_t> requestBatch(const std::vector<int>& keys) override {
+        calls.fetch_add(1, std::memory_order_relaxed); // One round trip for the whole batch
+        std::this_thread::sleep_for(latency);
+        std::vector<uint64_t> results;
+        results.reserve(keys.size());
+        for (int key : keys) {
+            results.push_back(static_cast<uint64_t>(key) * 2654435761u);
+        }
+        return results;
+    }
+
+    uint64_t callCount() const { return calls.load(std::memory_order_relaxed); }
+};
+
+// SaturatingBackend: Simulated server with a fixed number of workers; excess calls queue up
+class SaturatingBackend : public Subject {
+private:
+    std::chrono::microseconds serviceTime;
+    int freeWorkers;
+    std::mutex mutex;
+    std::condition_variable workerFreed;
+
+public:
+    SaturatingBackend(int workers, std::chrono::microseconds callServiceTime)
+        : serviceTime(callServiceTime), freeWorkers(workers) {}
 
-        std::cout << "Proxy: Forwarding request to RealSubject.\n";
-        realSubject->request();
+    void request() override {
+        request(0);
+    }
+
+    uint64_t request(int key) override {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            workerFreed.wait(lock, [this] { return freeWorkers > 0; });
+            --freeWorkers;
+        }
+        std::this_thread::sleep_for(serviceTime);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++freeWorkers;
+        }
+        workerFreed.notify_one();
+        return static_cast<uint64_t>(key);
     }
 };
 
+// Benchmark: throughput and p50/p99 latency against offered load, with and without admission control
+void benchmarkAdmission() {
+    using Clock = std::chrono::steady_clock;
+    const int workers = 4;
+    const std::chrono::microseconds serviceTime(1000); // Backend capacity: 4000 requests/s
+    const std::chrono::milliseconds duration(300);
+    const int clientCount = 64;
+
+    auto run = [&](Subject& entry, double offeredPerSecond, bool protectedPath) {
+        std::vector<std::vector<double>> latencies(clientCount);
+        std::atomic<uint64_t> rejected(0);
+        std::vector<std::thread> clients;
+        // Open-loop load: every client issues requests on its own fixed schedule
+        auto interval = std::chrono::duration<double>(clientCount / offeredPerSecond);
+        auto start = Clock::now();
+        for (int c = 0; c < clientCount; ++c) {
+            clients.emplace_back([&, c] {
+                auto due = start + std::chrono::duration_cast<Clock::duration>(interval * c / clientCount);
+                while (due < start + duration) {
+                    std::this_thread::sleep_until(due);
+                    due += std::chrono::duration_cast<Clock::duration>(interval);
+                    auto sent = Clock::now();
+                    try {
+                        entry.request(c);
+                        latencies[c].push_back(std::chrono::duration<double, std::micro>(Clock::now() - sent).count());
+                    }
+                    catch (const AdmissionRejected&) {
+                        rejected.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            });
+        }
+        for (auto& client : clients) {
+            client.join();
+        }
+        double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::vector<double> all;
+        for (const auto& perClient : latencies) {
+            all.insert(all.end(), perClient.begin(), perClient.end());
+        }
+        std::sort(all.begin(), all.end());
+        output() << (protectedPath ? "  admission" : "  direct   ") << " offered " << offeredPerSecond
+                 << "/s -> served " << all.size() / elapsed << "/s, shed " << rejected.load();
+        if (!all.empty()) {
+            output() << ", p50 " << all[all.size() / 2] << " us, p99 " << all[all.size() * 99 / 100] << " us";
+        }
+        output() << "\n";
+    };
+
+    output() << "Throughput and latency vs offered load (capacity " << workers * 1000 << "/s):\n";
+    for (double offered : { 1000.0, 2000.0, 4000.0, 8000.0, 16000.0 }) {
+        SaturatingBackend direct(workers, serviceTime);
+        run(direct, offered, false);
+
+        SaturatingBackend backend(workers, serviceTime);
+        AdmissionProxy::Limits limits;
+        limits.ratePerSecond = workers * 1000.0;
+        limits.burst = 50;
+        limits.maxConcurrency = workers;
+        limits.maxQueue = workers * 2;
+        limits.maxQueueWait = std::chrono::microseconds(3000);
+        AdmissionProxy admission(backend, limits);
+        run(admission, offered, true);
+    }
+    flushOutput();
+}
+
+// Benchmark: backend call reduction and p99 latency of coalescing proxies over a slow backend
+void benchmarkCoalescing() {
+    using Clock = std::chrono::steady_clock;
+    const int clientCount = 32;
+    const int requestsPerClient = 50;
+    const int keyCount = 8; // Few hot keys so many concurrent requests are identical
+
+    auto run = [&](const char* label, SlowBackend& backend, Subject& entry) {
+        std::vector<std::vector<double>> latencies(clientCount);
+        std::vector<std::thread> clients;
+        for (int c = 0; c < clientCount; ++c) {
+            clients.emplace_back([&, c] {
+                for (int i = 0; i < requestsPerClient; ++i) {
+                    auto start = Clock::now();
+                    entry.request((c + i) % keyCount);
+                    latencies[c].push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+                }
+            });
+        }
+        for (auto& client : clients) {
+            client.join();
+        }
+
+        std::vector<double> all;
+        for (const auto& perClient : latencies) {
+            all.insert(all.end(), perClient.begin(), perClient.end());
+        }
+        std::sort(all.begin(), all.end());
+        output() << label << ": " << backend.callCount() << " backend calls for " << all.size()
+                 << " requests, p50 " << all[all.size() / 2] << " us, p99 "
+                 << all[all.size() * 99 / 100] << " us\n";
+    };
+
+    const std::chrono::microseconds latency(1000);
+    {
+        SlowBackend backend(latency);
+        run("Direct       ", backend, backend);
+    }
+    {
+        SlowBackend backend(latency);
+        SingleFlightProxy singleFlight(backend);
+        run("Single-flight", backend, singleFlight);
+    }
+    {
+        SlowBackend backend(latency);
+        BatchingProxy batching(backend, std::chrono::microseconds(200));
+        run("Micro-batch  ", backend, batching);
+    }
+    flushOutput();
+}
+
+// Benchmark: cold-start latency with and without warm-up, and cached vs uncached call latency
+void benchmarkProxy() {
+    using Clock = std::chrono::steady_clock;
+    auto microseconds = [](Clock::duration d) {
+        return std::chrono::duration<double, std::micro>(d).count();
+    };
+
+    {
+        Proxy cold;
+        auto start = Clock::now();
+        cold.request(1);
+        output() << "Cold start without warm-up: " << microseconds(Clock::now() - start) << " us\n";
+    }
+    {
+        Proxy warm;
+        warm.warmUp();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100)); // Client does other work meanwhile
+        auto start = Clock::now();
+        warm.request(1);
+        output() << "Cold start after warm-up:   " << microseconds(Clock::now() - start) << " us\n";
+    }
+
+    const int callCount = 200000;
+    const int keyCount = 1000;
+    Proxy proxy;
+    proxy.warmUp();
+    CachingProxy cache(proxy, keyCount);
+    uint64_t checksum = 0;
+
+    auto start = Clock::now();
+    for (int i = 0; i < callCount; ++i) {
+        checksum += proxy.request(i % keyCount);
+    }
+    double uncached = microseconds(Clock::now() - start) * 1000.0 / callCount;
+
+    start = Clock::now();
+    for (int i = 0; i < callCount; ++i) {
+        checksum += cache.request(i % keyCount);
+    }
+    double cached = microseconds(Clock::now() - start) * 1000.0 / callCount;
+
+    output() << "Uncached call: " << uncached << " ns, cached call: " << cached << " ns"
+             << " (hits " << cache.hitCount() << ", misses " << cache.missCount()
+             << ", checksum " << checksum % 1000 << ")\n";
+    flushOutput();
+}
+
 // Client code
 int main() {
     Proxy proxy;
-    std::cout << "Client: Requesting through Proxy...\n";
+    output() << "Client: Requesting through Proxy...\n";
     proxy.request(); // First call creates the RealSubject
-    std::cout << "Client: Requesting again...\n";
+    output() << "Client: Requesting again...\n";
     proxy.request(); // Second call reuses the existing RealSubject
+
+    // Concurrent first calls still create exactly one RealSubject
+    Proxy shared;
+    std::vector<std::thread> clients;
+    for (int i = 0; i < 4; ++i) {
+        clients.emplace_back([&shared, i] { shared.request(i); });
+    }
+    for (auto& client : clients) {
+        client.join();
+    }
+
+    benchmarkProxy();
+    benchmarkCoalescing();
+    benchmarkAdmission();
     return 0;
-}
\ No newline at end of file
+}
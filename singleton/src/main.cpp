@@ -10,13 +10,13 @@
 */
 
 // Include standard headers
-#include <iostream>
+#include "../../common/output_sink.h"
 
 class Singleton {
 private:
     // Private constructor to prevent direct instantiation
     Singleton() {
-        std::cout << "Singleton Instance Created" << std::endl;
+        output() << "Singleton Instance Created\n";
     }
 
     // Deleting copy constructor to prevent copying
@@ -48,7 +48,7 @@ int main() {
 
     // Verify that both instances are the same
     if (s1 == s2) {
-        std::cout << "Both instances are the same!" << std::endl;
+        output() << "Both instances are the same!\n";
     }
 
     return 0;
@@ -5,7 +5,7 @@
 */
 
 // Include necessary headers
-#include <iostream>
+#include "../../common/output_sink.h"
 #include <memory> // For std::unique_ptr
 
  // Define the Strategy interface
@@ -19,14 +19,14 @@ public:
 class ConcreteStrategyA : public Strategy {
 public:
     void execute() const override {
-        std::cout << "Executing Strategy A" << std::endl;
+        output() << "Executing Strategy A\n";
     }
 };
 
 class ConcreteStrategyB : public Strategy {
 public:
     void execute() const override {
-        std::cout << "Executing Strategy B" << std::endl;
+        output() << "Executing Strategy B\n";
     }
 };
 
@@ -50,7 +50,7 @@ public:
             strategy->execute();
         }
         else {
-            std::cout << "No strategy set!" << std::endl;
+            output() << "No strategy set!\n";
         }
     }
 };
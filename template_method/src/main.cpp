@@ -10,7 +10,7 @@
 */
 
 // Include necessary headers
-#include <iostream>
+#include "../../common/output_sink.h"
 
 // Abstract base class defining the template method
 class Beverage {
@@ -26,11 +26,11 @@ public:
 protected:
     // Common steps implemented in base class
     void boilWater() {
-        std::cout << "Boiling water..." << std::endl;
+        output() << "Boiling water...\n";
     }
 
     void pourInCup() {
-        std::cout << "Pouring into cup..." << std::endl;
+        output() << "Pouring into cup...\n";
     }
 
     // Steps to be defined by subclasses
@@ -42,11 +42,11 @@ protected:
 class Tea : public Beverage {
 protected:
     void brew() override {
-        std::cout << "Steeping the tea..." << std::endl;
+        output() << "Steeping the tea...\n";
     }
 
     void addCondiments() override {
-        std::cout << "Adding lemon..." << std::endl;
+        output() << "Adding lemon...\n";
     }
 };
 
@@ -54,23 +54,23 @@ protected:
 class Coffee : public Beverage {
 protected:
     void brew() override {
-        std::cout << "Dripping coffee through filter..." << std::endl;
+        output() << "Dripping coffee through filter...\n";
     }
 
     void addCondiments() override {
-        std::cout << "Adding sugar and milk..." << std::endl;
+        output() << "Adding sugar and milk...\n";
     }
 };
 
 // Main function to demonstrate the template method pattern
 int main() {
 	// Create instance of Tea and call the template method
-    std::cout << "Making tea:" << std::endl;
+    output() << "Making tea:\n";
     Tea tea;
     tea.prepareRecipe();
 
     // Create instance of Coffee and call the template method
-    std::cout << "\nMaking coffee:" << std::endl;
+    output() << "\nMaking coffee:\n";
     Coffee coffee;
     coffee.prepareRecipe();
 
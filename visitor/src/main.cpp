@@ -8,10 +8,28 @@
              Concrete Visitor: Implements the visit methods to define new behavior.
              Element Interface: Declares an accept method that takes a visitor.
              Concrete Elements: Implement the accept method by calling the appropriate visitor method.
+
+             For a closed hierarchy, elements can instead be stored by value in a
+             std::vector<std::variant<...>> or in one array per type, and visited with
+             std::visit or type-segregated loops that the compiler can inline.
+
+             ParallelVisitation applies a visitor to a large collection on a thread pool. Each
+             worker gets its own visitor instance, and a reduce step merges the per-worker results.
 */
 
 // Include necessary headers
-#include <iostream>
+#include "../../common/output_sink.h"
+#include <vector>
+#include <variant>
+#include <memory>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <algorithm>
 
 // Forward declarations of concrete element classes
 class ElementA;
@@ -28,11 +46,16 @@ public:
 class Element {
 public:
     virtual void accept(Visitor& visitor) = 0; // Accept method for Visitor
+    virtual ~Element() {}
 };
 
 // Concrete Element A
 class ElementA : public Element {
+private:
+    int64_t count;
 public:
+    ElementA(int64_t value = 0) : count(value) {}
+    int64_t getCount() const { return count; }
     void accept(Visitor& visitor) override {
         visitor.visit(*this); // Calls the appropriate visit method
     }
@@ -40,7 +63,11 @@ public:
 
 // Concrete Element B
 class ElementB : public Element {
+private:
+    double weight;
 public:
+    ElementB(double value = 0) : weight(value) {}
+    double getWeight() const { return weight; }
     void accept(Visitor& visitor) override {
         visitor.visit(*this); // Calls the appropriate visit method
     }
@@ -50,14 +77,283 @@ public:
 class ConcreteVisitor : public Visitor {
 public:
     void visit(ElementA& element) override {
-        std::cout << "Visiting ElementA" << std::endl;
+        output() << "Visiting ElementA\n";
     }
 
     void visit(ElementB& element) override {
-        std::cout << "Visiting ElementB" << std::endl;
+        output() << "Visiting ElementB\n";
     }
 };
 
+// Concrete Visitor that totals the values of the elements it visits
+class SumVisitor : public Visitor {
+public:
+    double total = 0;
+    void visit(ElementA& element) override { total += element.getCount(); }
+    void visit(ElementB& element) override { total += element.getWeight(); }
+};
+
+// Concrete Visitor that counts elements per type
+class CountVisitor : public Visitor {
+public:
+    size_t countA = 0;
+    size_t countB = 0;
+    void visit(ElementA&) override { ++countA; }
+    void visit(ElementB&) override { ++countB; }
+};
+
+// Closed-hierarchy mode: elements stored by value, visited without double dispatch
+using ElementVariant = std::variant<ElementA, ElementB>;
+
+// std::visit callable with the same behaviour as SumVisitor; non-virtual, so it inlines
+struct SumVisit {
+    double& total;
+    void operator()(const ElementA& element) const { total += element.getCount(); }
+    void operator()(const ElementB& element) const { total += element.getWeight(); }
+};
+
+// Type-segregated storage: one homogeneous array per element type
+class ElementArrays {
+private:
+    std::vector<ElementA> elementsA;
+    std::vector<ElementB> elementsB;
+public:
+    void add(const ElementA& element) { elementsA.push_back(element); }
+    void add(const ElementB& element) { elementsB.push_back(element); }
+
+    // Visits all ElementA, then all ElementB; order across types is not preserved
+    template <typename Visit>
+    void forEach(Visit&& visit) const {
+        for (const ElementA& element : elementsA) {
+            visit(element);
+        }
+        for (const ElementB& element : elementsB) {
+            visit(element);
+        }
+    }
+};
+
+// Benchmark: visiting 10M mixed elements through double dispatch, std::visit and segregated arrays
+void benchmarkVisitation() {
+    using Clock = std::chrono::steady_clock;
+    const size_t elementCount = 10000000;
+
+    std::vector<std::unique_ptr<Element>> objects;
+    std::vector<ElementVariant> variants;
+    ElementArrays arrays;
+    objects.reserve(elementCount);
+    variants.reserve(elementCount);
+    uint64_t seed = 7;
+    for (size_t i = 0; i < elementCount; ++i) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        if ((seed >> 63) != 0) { // Random mix so the element type is unpredictable
+            ElementA element(static_cast<int64_t>(i % 100));
+            objects.emplace_back(new ElementA(element));
+            variants.emplace_back(element);
+            arrays.add(element);
+        }
+        else {
+            ElementB element(0.5);
+            objects.emplace_back(new ElementB(element));
+            variants.emplace_back(element);
+            arrays.add(element);
+        }
+    }
+
+    auto report = [&](const char* label, Clock::time_point start, double total) {
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        output() << label << elementCount / seconds / 1e6 << " M elements/s (total " << total << ")\n";
+    };
+
+    auto start = Clock::now();
+    SumVisitor visitor;
+    for (const auto& element : objects) {
+        element->accept(visitor);
+    }
+    report("accept/visit:       ", start, visitor.total);
+
+    start = Clock::now();
+    double variantTotal = 0;
+    for (const auto& element : variants) {
+        std::visit(SumVisit{ variantTotal }, element);
+    }
+    report("std::visit:         ", start, variantTotal);
+
+    start = Clock::now();
+    double arraysTotal = 0;
+    arrays.forEach(SumVisit{ arraysTotal });
+    report("segregated arrays:  ", start, arraysTotal);
+    flushOutput();
+}
+
+// ParallelVisitation: Applies visitors to element collections on a fixed pool of worker threads
+class ParallelVisitation {
+public:
+    enum class Ordering {
+        Ordered,   // Contiguous range per worker, merged in collection order; deterministic
+        Unordered  // Chunks claimed dynamically for load balance; merge order depends on timing
+    };
+
+private:
+    static const size_t chunkSize = 16 * 1024;
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::function<void(size_t)> job;
+    uint64_t generation = 0;
+    size_t running = 0;
+    bool stopping = false;
+
+    void workerLoop(size_t index) {
+        uint64_t seen = 0;
+        for (;;) {
+            std::function<void(size_t)>* current;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) {
+                    return;
+                }
+                seen = generation;
+                current = &job;
+            }
+            (*current)(index);
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--running == 0) {
+                done.notify_one();
+            }
+        }
+    }
+
+    // Run work(workerIndex) once on every worker and wait for all of them
+    void runOnAll(std::function<void(size_t)> work) {
+        std::unique_lock<std::mutex> lock(mutex);
+        job = std::move(work);
+        running = workers.size();
+        ++generation;
+        wake.notify_all();
+        done.wait(lock, [&] { return running == 0; });
+    }
+
+    // Per-worker visitor padded to its own cache line
+    template <typename VisitorType>
+    struct alignas(64) Slot {
+        VisitorType visitor;
+    };
+
+public:
+    explicit ParallelVisitation(size_t threadCount) {
+        threadCount = std::max<size_t>(1, threadCount);
+        for (size_t i = 0; i < threadCount; ++i) {
+            workers.emplace_back(&ParallelVisitation::workerLoop, this, i);
+        }
+    }
+
+    ~ParallelVisitation() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    ParallelVisitation(const ParallelVisitation&) = delete;
+    ParallelVisitation& operator=(const ParallelVisitation&) = delete;
+
+    size_t threadCount() const { return workers.size(); }
+
+    // Visit every element with a worker-local VisitorType, then fold the workers' visitors into
+    // one with reduce(into, from). The worker visitors are reduced in worker order.
+    template <typename VisitorType, typename Reduce>
+    VisitorType apply(std::vector<std::unique_ptr<Element>>& elements, Reduce reduce,
+                      Ordering ordering = Ordering::Ordered) {
+        const size_t workerCount = workers.size();
+        std::vector<Slot<VisitorType>> slots(workerCount);
+        std::atomic<size_t> nextChunk(0);
+
+        runOnAll([&](size_t worker) {
+            VisitorType& visitor = slots[worker].visitor;
+            if (ordering == Ordering::Ordered) {
+                size_t begin = elements.size() * worker / workerCount;
+                size_t end = elements.size() * (worker + 1) / workerCount;
+                for (size_t i = begin; i < end; ++i) {
+                    elements[i]->accept(visitor);
+                }
+                return;
+            }
+            for (;;) {
+                size_t begin = nextChunk.fetch_add(chunkSize, std::memory_order_relaxed);
+                if (begin >= elements.size()) {
+                    return;
+                }
+                size_t end = std::min(begin + chunkSize, elements.size());
+                for (size_t i = begin; i < end; ++i) {
+                    elements[i]->accept(visitor);
+                }
+            }
+        });
+
+        VisitorType result = std::move(slots[0].visitor);
+        for (size_t i = 1; i < workerCount; ++i) {
+            reduce(result, slots[i].visitor);
+        }
+        return result;
+    }
+};
+
+// Benchmark: scaling of ParallelVisitation with sum and count visitors over 10M elements
+void benchmarkParallelVisitation() {
+    using Clock = std::chrono::steady_clock;
+    const size_t elementCount = 10000000;
+
+    std::vector<std::unique_ptr<Element>> elements;
+    elements.reserve(elementCount);
+    for (size_t i = 0; i < elementCount; ++i) {
+        if (i % 3 == 0) {
+            elements.emplace_back(new ElementB(0.5));
+        }
+        else {
+            elements.emplace_back(new ElementA(static_cast<int64_t>(i % 100)));
+        }
+    }
+
+    auto reduceSum = [](SumVisitor& into, const SumVisitor& from) { into.total += from.total; };
+    auto reduceCount = [](CountVisitor& into, const CountVisitor& from) {
+        into.countA += from.countA;
+        into.countB += from.countB;
+    };
+
+    size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t threads = 1; ; threads = std::min(threads * 2, maxThreads)) {
+        ParallelVisitation pool(threads);
+        for (ParallelVisitation::Ordering ordering : { ParallelVisitation::Ordering::Ordered,
+                                                       ParallelVisitation::Ordering::Unordered }) {
+            auto start = Clock::now();
+            SumVisitor sum = pool.apply<SumVisitor>(elements, reduceSum, ordering);
+            double sumSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+            start = Clock::now();
+            CountVisitor count = pool.apply<CountVisitor>(elements, reduceCount, ordering);
+            double countSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+            output() << threads << " threads, "
+                     << (ordering == ParallelVisitation::Ordering::Ordered ? "ordered:   " : "unordered: ")
+                     << "sum " << elementCount / sumSeconds / 1e6 << " M/s (" << sum.total << "), "
+                     << "count " << elementCount / countSeconds / 1e6 << " M/s ("
+                     << count.countA << " A, " << count.countB << " B)\n";
+        }
+        if (threads == maxThreads) {
+            break;
+        }
+    }
+    flushOutput();
+}
+
 int main() {
 	// Create instances of elements and visitor
     ElementA a;
@@ -68,5 +364,8 @@ int main() {
     a.accept(visitor); // Visiting ElementA
     b.accept(visitor); // Visiting ElementB
 
+    benchmarkVisitation();
+    benchmarkParallelVisitation();
+
     return 0;
 }